@@ -8,10 +8,16 @@
  */
 
 #include <gbBase/config.hpp>
+#include <gbBase/Assert.hpp>
 
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace GHULBUS_BASE_NAMESPACE
 {
@@ -19,52 +25,417 @@ namespace GHULBUS_BASE_NAMESPACE
 template<typename Signature>
 class AnyInvocable;
 
-template<typename T_Return, typename... T_Args>
-class AnyInvocable<T_Return(T_Args...)> {
+namespace impl {
+template<typename T>
+struct IsAnyInvocable : std::false_type {};
+
+template<typename Signature>
+struct IsAnyInvocable<AnyInvocable<Signature>> : std::true_type {};
+
+template<typename T>
+struct IsInPlaceType : std::false_type {};
+
+template<typename T>
+struct IsInPlaceType<std::in_place_type_t<T>> : std::true_type {};
+
+/** std::invoke_r from C++23.
+ */
+template<typename T_Return, typename F, typename... T_Args>
+constexpr T_Return invokeR(F&& f, T_Args&&... args) noexcept(std::is_nothrow_invocable_r_v<T_Return, F, T_Args...>)
+{
+    if constexpr (std::is_void_v<T_Return>) {
+        std::invoke(std::forward<F>(f), std::forward<T_Args>(args)...);
+    } else {
+        return std::invoke(std::forward<F>(f), std::forward<T_Args>(args)...);
+    }
+}
+
+/** Storage and type erased operations shared by all AnyInvocable specializations and InplaceInvocable.
+ * Instead of a virtual interface, the type erased operations are dispatched through a static table of function
+ * pointers. The pointer to the invoke function is stored directly in the object, so that a call only requires
+ * a single indirect jump. Moving an object holding a trivially copyable callable, or a callable on the heap,
+ * amounts to copying its storage.
+ * @tparam InlineSize Size in bytes of the buffer for callables that are stored inline.
+ * @tparam InlineAlignment Alignment of the buffer for callables that are stored inline.
+ */
+template<std::size_t InlineSize, std::size_t InlineAlignment, bool IsNoexcept, typename T_Return, typename... T_Args>
+class AnyInvocableBase {
+protected:
+    union Storage {
+        void* heap;
+        alignas(InlineAlignment) std::byte buffer[InlineSize];
+    };
+
+    using Invoker = T_Return(*)(Storage&, T_Args&&...) noexcept(IsNoexcept);
 private:
-    class Concept {
-    public:
-        virtual ~Concept() = default;
-        virtual T_Return invoke(T_Args... args) const = 0;
+    /** Type erased operations for the stored callable.
+     * A null relocate means that the storage can be moved by copying its bytes.
+     * A null destroy means that there is nothing to destroy.
+     */
+    struct VTable {
+        void (*relocate)(Storage& dst, Storage& src) noexcept;
+        void (*destroy)(Storage& s) noexcept;
     };
 
-    template<typename F>
-    class Model : public Concept {
-        mutable F f;
-    public:
-        Model(F&& nf) noexcept(std::is_nothrow_move_constructible_v<F>)
-            :f(std::move(nf))
-        {}
+    static constexpr VTable empty_vtable{ nullptr, nullptr };
+
+    /** @tparam T_Inv The qualified type of the callable used for invocation, e.g. `F const&`.
+     */
+    template<typename F, typename T_Inv>
+    struct InlineModel {
+        static F& get(Storage& s) noexcept {
+            return *std::launder(reinterpret_cast<F*>(&s.buffer));
+        }
+
+        static T_Return invoke(Storage& s, T_Args&&... args) noexcept(IsNoexcept) {
+            return invokeR<T_Return>(static_cast<T_Inv>(get(s)), std::forward<T_Args>(args)...);
+        }
+
+        static void relocate(Storage& dst, Storage& src) noexcept {
+            ::new(&dst.buffer) F(std::move(get(src)));
+            get(src).~F();
+        }
 
-        ~Model() override = default;
+        static void destroy(Storage& s) noexcept {
+            get(s).~F();
+        }
+
+        static constexpr bool is_trivial = std::is_trivially_copyable_v<F>;
+        static constexpr VTable vtable{ is_trivial ? nullptr : &relocate, is_trivial ? nullptr : &destroy };
+    };
+
+    template<typename F, typename T_Inv>
+    struct HeapModel {
+        static F& get(Storage& s) noexcept {
+            return *static_cast<F*>(s.heap);
+        }
+
+        static T_Return invoke(Storage& s, T_Args&&... args) noexcept(IsNoexcept) {
+            return invokeR<T_Return>(static_cast<T_Inv>(get(s)), std::forward<T_Args>(args)...);
+        }
+
+        static void destroy(Storage& s) noexcept {
+            delete static_cast<F*>(s.heap);
+        }
+
+        static constexpr VTable vtable{ nullptr, &destroy };
+    };
+
+    /** Model for callables stored in memory obtained from an allocator.
+     * The allocator is stored next to the callable, so that it is available for deallocation.
+     */
+    template<typename F, typename T_Inv, typename Alloc>
+    struct AllocatedModel {
+        struct Box {
+            Alloc allocator;
+            F f;
+
+            template<typename... T_CtorArgs>
+            explicit Box(Alloc const& alloc, T_CtorArgs&&... ctor_args)
+                :allocator(alloc), f(std::forward<T_CtorArgs>(ctor_args)...)
+            {}
+        };
+        using BoxAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Box>;
+        using BoxTraits = std::allocator_traits<BoxAllocator>;
+
+        static Box& box(Storage& s) noexcept {
+            return *static_cast<Box*>(s.heap);
+        }
 
-        T_Return invoke(T_Args... args) const override {
-            return std::invoke(f, std::forward<T_Args>(args)...);
+        static T_Return invoke(Storage& s, T_Args&&... args) noexcept(IsNoexcept) {
+            return invokeR<T_Return>(static_cast<T_Inv>(box(s).f), std::forward<T_Args>(args)...);
         }
+
+        template<typename... T_CtorArgs>
+        static void* create(Alloc const& alloc, T_CtorArgs&&... ctor_args) {
+            BoxAllocator box_alloc(alloc);
+            Box* const p = std::to_address(BoxTraits::allocate(box_alloc, 1));
+            try {
+                ::new(static_cast<void*>(p)) Box(alloc, std::forward<T_CtorArgs>(ctor_args)...);
+            } catch (...) {
+                BoxTraits::deallocate(box_alloc, p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        static void destroy(Storage& s) noexcept {
+            Box* const p = &box(s);
+            BoxAllocator box_alloc(p->allocator);
+            p->~Box();
+            BoxTraits::deallocate(box_alloc, p, 1);
+        }
+
+        static constexpr VTable vtable{ nullptr, &destroy };
     };
+protected:
+    Invoker m_invoke = nullptr;
+    VTable const* m_vtable = &empty_vtable;
+    mutable Storage m_storage;
 public:
-    AnyInvocable() noexcept = default;
+    /** Checks whether a callable of type `F` will be stored inline, without allocating memory.
+     */
+    template<typename F>
+    static constexpr bool storesInline() noexcept
+    {
+        return (sizeof(F) <= InlineSize) && (alignof(F) <= InlineAlignment) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+    bool empty() const noexcept {
+        return !m_invoke;
+    }
+
+    explicit operator bool() const noexcept {
+        return m_invoke != nullptr;
+    }
+protected:
+    AnyInvocableBase() noexcept = default;
+
+    ~AnyInvocableBase()
+    {
+        reset();
+    }
 
-    template<typename Func>
-    AnyInvocable(Func f)
-        :m_ptr(std::make_unique<Model<Func>>(std::move(f)))
-    {}
+    AnyInvocableBase(AnyInvocableBase&& rhs) noexcept
+    {
+        takeFrom(rhs);
+    }
 
-    AnyInvocable(AnyInvocable&&) noexcept = default;
-    AnyInvocable& operator=(AnyInvocable&&) noexcept = default;
+    AnyInvocableBase& operator=(AnyInvocableBase&& rhs) noexcept
+    {
+        if (&rhs != this) {
+            reset();
+            takeFrom(rhs);
+        }
+        return *this;
+    }
 
-    T_Return operator()(T_Args... args) const
+    /** Constructs a callable of type `F` in place.
+     * \pre The object is empty.
+     */
+    template<typename F, typename T_Inv, typename... T_CtorArgs>
+    void emplace(T_CtorArgs&&... ctor_args)
     {
-        return m_ptr->invoke(std::forward<T_Args>(args)...);
+        if constexpr (storesInline<F>()) {
+            ::new(&m_storage.buffer) F(std::forward<T_CtorArgs>(ctor_args)...);
+            m_invoke = &InlineModel<F, T_Inv>::invoke;
+            m_vtable = &InlineModel<F, T_Inv>::vtable;
+        } else {
+            m_storage.heap = new F(std::forward<T_CtorArgs>(ctor_args)...);
+            m_invoke = &HeapModel<F, T_Inv>::invoke;
+            m_vtable = &HeapModel<F, T_Inv>::vtable;
+        }
     }
 
-    bool empty() const {
-        return !m_ptr;
+    /** Constructs a callable of type `F` in place, using the given allocator if it is not stored inline.
+     * A pointer to a `std::pmr::memory_resource` may be passed instead of an allocator.
+     * \pre The object is empty.
+     */
+    template<typename F, typename T_Inv, typename Alloc, typename... T_CtorArgs>
+    void emplaceWithAllocator(Alloc const& alloc, T_CtorArgs&&... ctor_args)
+    {
+        if constexpr (std::is_convertible_v<Alloc, std::pmr::memory_resource*>) {
+            emplaceWithAllocator<F, T_Inv>(std::pmr::polymorphic_allocator<std::byte>(alloc),
+                                           std::forward<T_CtorArgs>(ctor_args)...);
+        } else if constexpr (storesInline<F>()) {
+            emplace<F, T_Inv>(std::forward<T_CtorArgs>(ctor_args)...);
+        } else {
+            m_storage.heap = AllocatedModel<F, T_Inv, Alloc>::create(alloc, std::forward<T_CtorArgs>(ctor_args)...);
+            m_invoke = &AllocatedModel<F, T_Inv, Alloc>::invoke;
+            m_vtable = &AllocatedModel<F, T_Inv, Alloc>::vtable;
+        }
+    }
+
+    /** Null function pointers and empty AnyInvocables result in an empty object.
+     */
+    template<typename F, typename Func>
+    static bool isNullCallable([[maybe_unused]] Func const& f) noexcept
+    {
+        if constexpr (std::is_same_v<std::remove_cvref_t<Func>, F> &&
+                      (std::is_pointer_v<F> || std::is_member_pointer_v<F> || IsAnyInvocable<F>::value))
+        {
+            return !f;
+        } else {
+            return false;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (m_vtable->destroy) {
+            m_vtable->destroy(m_storage);
+        }
+        m_invoke = nullptr;
+        m_vtable = &empty_vtable;
+    }
+
+    void swapWith(AnyInvocableBase& rhs) noexcept
+    {
+        AnyInvocableBase tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
     }
 private:
-    std::unique_ptr<Concept> m_ptr;
+    void takeFrom(AnyInvocableBase& rhs) noexcept
+    {
+        if (rhs.m_vtable->relocate) {
+            rhs.m_vtable->relocate(m_storage, rhs.m_storage);
+        } else if (rhs.m_invoke) {
+            std::memcpy(&m_storage, &rhs.m_storage, sizeof(Storage));
+        }
+        m_invoke = std::exchange(rhs.m_invoke, nullptr);
+        m_vtable = std::exchange(rhs.m_vtable, &empty_vtable);
+    }
 };
+}
+
+/** Defines the AnyInvocable specialization for one combination of signature qualifiers.
+ * @param CV Either `const` or nothing.
+ * @param REF The ref-qualifier of the signature: `&`, `&&` or nothing.
+ * @param INV_REF The ref-qualifier used for invoking the stored callable: `&&` if REF is `&&`, otherwise `&`.
+ * @param NOEX Either `true` or `false`.
+ */
+#define GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(CV, REF, INV_REF, NOEX)                                         \
+template<typename T_Return, typename... T_Args>                                                                       \
+class AnyInvocable<T_Return(T_Args...) CV REF noexcept(NOEX)>                                                         \
+    : public impl::AnyInvocableBase<3 * sizeof(void*), alignof(void*), NOEX, T_Return, T_Args...>                     \
+{                                                                                                                     \
+private:                                                                                                              \
+    using Base = impl::AnyInvocableBase<3 * sizeof(void*), alignof(void*), NOEX, T_Return, T_Args...>;                \
+                                                                                                                      \
+    template<typename F>                                                                                              \
+    using InvokeAs = F CV INV_REF;                                                                                    \
+                                                                                                                      \
+    template<typename F, typename T_Inv>                                                                              \
+    static constexpr bool isInvocableAs() noexcept {                                                                  \
+        if constexpr (NOEX) {                                                                                         \
+            return std::is_nothrow_invocable_r_v<T_Return, T_Inv, T_Args...>;                                         \
+        } else {                                                                                                      \
+            return std::is_invocable_r_v<T_Return, T_Inv, T_Args...>;                                                 \
+        }                                                                                                             \
+    }                                                                                                                 \
+                                                                                                                      \
+    template<typename F>                                                                                              \
+    static constexpr bool is_callable_from = isInvocableAs<F, F CV REF>() && isInvocableAs<F, InvokeAs<F>>();         \
+public:                                                                                                               \
+    using result_type = T_Return;                                                                                     \
+                                                                                                                      \
+    AnyInvocable() noexcept = default;                                                                                \
+                                                                                                                      \
+    AnyInvocable(std::nullptr_t) noexcept                                                                             \
+    {}                                                                                                                \
+                                                                                                                      \
+    template<typename Func, typename F = std::decay_t<Func>,                                                          \
+             typename = std::enable_if_t<!std::is_same_v<F, AnyInvocable> && !impl::IsInPlaceType<F>::value &&        \
+                                         is_callable_from<F>>>                                                        \
+    AnyInvocable(Func&& f)                                                                                            \
+    {                                                                                                                 \
+        if (!Base::template isNullCallable<F>(f)) {                                                                   \
+            this->template emplace<F, InvokeAs<F>>(std::forward<Func>(f));                                            \
+        }                                                                                                             \
+    }                                                                                                                 \
+                                                                                                                      \
+    /** Constructs a callable of type `F` in place from the given constructor arguments.                              \
+     */                                                                                                               \
+    template<typename F, typename... T_CtorArgs>                                                                      \
+    explicit AnyInvocable(std::in_place_type_t<F>, T_CtorArgs&&... ctor_args)                                         \
+    {                                                                                                                 \
+        static_assert(std::is_same_v<F, std::decay_t<F>>, "In-place type must be an object type.");                  \
+        static_assert(is_callable_from<F>, "In-place type is not callable with the given signature.");                \
+        this->template emplace<F, InvokeAs<F>>(std::forward<T_CtorArgs>(ctor_args)...);                              \
+    }                                                                                                                 \
+                                                                                                                      \
+    /** Constructs from a callable, obtaining memory from the given allocator if it cannot be stored inline.          \
+     * @param[in] alloc An allocator or a pointer to a `std::pmr::memory_resource`.                                   \
+     */                                                                                                               \
+    template<typename Alloc, typename Func, typename F = std::decay_t<Func>,                                          \
+             typename = std::enable_if_t<!std::is_same_v<F, AnyInvocable> && !impl::IsInPlaceType<F>::value &&        \
+                                         is_callable_from<F>>>                                                        \
+    AnyInvocable(std::allocator_arg_t, Alloc const& alloc, Func&& f)                                                  \
+    {                                                                                                                 \
+        if (!Base::template isNullCallable<F>(f)) {                                                                   \
+            this->template emplaceWithAllocator<F, InvokeAs<F>>(alloc, std::forward<Func>(f));                        \
+        }                                                                                                             \
+    }                                                                                                                 \
+                                                                                                                      \
+    /** Constructs a callable of type `F` in place, obtaining memory from the given allocator if it cannot be         \
+     * stored inline.                                                                                                 \
+     * @param[in] alloc An allocator or a pointer to a `std::pmr::memory_resource`.                                   \
+     */                                                                                                               \
+    template<typename Alloc, typename F, typename... T_CtorArgs>                                                      \
+    AnyInvocable(std::allocator_arg_t, Alloc const& alloc, std::in_place_type_t<F>, T_CtorArgs&&... ctor_args)        \
+    {                                                                                                                 \
+        static_assert(std::is_same_v<F, std::decay_t<F>>, "In-place type must be an object type.");                  \
+        static_assert(is_callable_from<F>, "In-place type is not callable with the given signature.");                \
+        this->template emplaceWithAllocator<F, InvokeAs<F>>(alloc, std::forward<T_CtorArgs>(ctor_args)...);           \
+    }                                                                                                                 \
+                                                                                                                      \
+    AnyInvocable(AnyInvocable&&) noexcept = default;                                                                  \
+    AnyInvocable& operator=(AnyInvocable&&) noexcept = default;                                                       \
+                                                                                                                      \
+    AnyInvocable& operator=(std::nullptr_t) noexcept                                                                  \
+    {                                                                                                                 \
+        this->reset();                                                                                                \
+        return *this;                                                                                                 \
+    }                                                                                                                 \
+                                                                                                                      \
+    template<typename Func, typename F = std::decay_t<Func>,                                                          \
+             typename = std::enable_if_t<!std::is_same_v<F, AnyInvocable> && is_callable_from<F>>>                    \
+    AnyInvocable& operator=(Func&& f)                                                                                 \
+    {                                                                                                                 \
+        AnyInvocable(std::forward<Func>(f)).swap(*this);                                                              \
+        return *this;                                                                                                 \
+    }                                                                                                                 \
+                                                                                                                      \
+    /** Invokes the stored callable.                                                                                  \
+     * \pre The object is not empty.                                                                                  \
+     */                                                                                                               \
+    T_Return operator()(T_Args... args) CV REF noexcept(NOEX)                                                         \
+    {                                                                                                                 \
+        GHULBUS_PRECONDITION(this->m_invoke);                                                                         \
+        return this->m_invoke(this->m_storage, std::forward<T_Args>(args)...);                                        \
+    }                                                                                                                 \
+                                                                                                                      \
+    void swap(AnyInvocable& rhs) noexcept                                                                             \
+    {                                                                                                                 \
+        this->swapWith(rhs);                                                                                          \
+    }                                                                                                                 \
+                                                                                                                      \
+    friend void swap(AnyInvocable& lhs, AnyInvocable& rhs) noexcept                                                   \
+    {                                                                                                                 \
+        lhs.swap(rhs);                                                                                                \
+    }                                                                                                                 \
+                                                                                                                      \
+    friend bool operator==(AnyInvocable const& f, std::nullptr_t) noexcept                                            \
+    {                                                                                                                 \
+        return f.empty();                                                                                             \
+    }                                                                                                                 \
+};
+
+/** An owning, move-only type erased wrapper for callable objects.
+ * This is modelled after `std::move_only_function`. The signature may carry `const`, `&`, `&&` and `noexcept`
+ * qualifiers, which are applied to the call operator and determine how the stored callable is invoked.
+ * For the unqualified signature `R(Args...)` the call operator is non-const.
+ *
+ * Small callables that are nothrow move constructible are stored inline in the AnyInvocable object without
+ * allocating memory. All other callables are stored on the heap, or in memory obtained from an allocator or
+ * `std::pmr::memory_resource` passed to one of the `std::allocator_arg_t` constructors.
+ */
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(, , &, false)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(, &, &, false)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(, &&, &&, false)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(const, , &, false)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(const, &, &, false)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(const, &&, &&, false)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(, , &, true)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(, &, &, true)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(, &&, &&, true)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(const, , &, true)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(const, &, &, true)
+GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION(const, &&, &&, true)
 
+#undef GHULBUS_INTERNAL_ANY_INVOCABLE_SPECIALIZATION
 }
 
 #endif
@@ -9,6 +9,8 @@
 
 #include <gbBase/config.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 
 #if defined GHULBUS_CONFIG_ASSERT_LEVEL_DEBUG && defined GHULBUS_CONFIG_ASSERT_LEVEL_PRODUCTION
@@ -23,6 +25,9 @@
  *  * Default level checks will be compiled unless `GHULBUS_CONFIG_ASSERT_LEVEL_PRODUCTION` is defined.
  *  * Debug level checks will only be compiled if `GHULBUS_CONFIG_ASSERT_LEVEL_DEBUG` is defined.
  *  * Production level checks will always be compiled.
+ *
+ * If `GHULBUS_CONFIG_ASSUME_PRECONDITIONS` is defined, precondition checks and unreachable markers that are not
+ * compiled are passed to \ref GHULBUS_ASSUME instead, so that the optimizer can make use of them.
  */
 #define GHULBUS_ASSERT(x)     GHULBUS_ASSERT_MESSAGE(x, nullptr)
 /** Debug-level assert.
@@ -63,12 +68,12 @@
 #   define GHULBUS_ASSERT_DBG_MESSAGE(x, msg)
 #   define GHULBUS_ASSERT_PRD_MESSAGE(x, msg)       GHULBUS_INTERNAL_ASSERT_IMPL(x, msg)
 
-#   define GHULBUS_PRECONDITION_MESSAGE(x, msg)
-#   define GHULBUS_PRECONDITION_DBG_MESSAGE(x, msg)
+#   define GHULBUS_PRECONDITION_MESSAGE(x, msg)     GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(x)
+#   define GHULBUS_PRECONDITION_DBG_MESSAGE(x, msg) GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(x)
 #   define GHULBUS_PRECONDITION_PRD_MESSAGE(x, msg) GHULBUS_INTERNAL_PRECONDITION_IMPL(x, msg)
 
-#   define GHULBUS_UNREACHABLE()
-#   define GHULBUS_UNREACHABLE_MESSAGE(msg)
+#   define GHULBUS_UNREACHABLE()                    GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(false)
+#   define GHULBUS_UNREACHABLE_MESSAGE(msg)         GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(false)
 #else
 /** Default-level assert with custom message.
  * @copydetails GHULBUS_ASSERT
@@ -90,7 +95,7 @@
 /** Debug-level precondition check with custom message.
  * @copydetails GHULBUS_ASSERT
  */
-#   define GHULBUS_PRECONDITION_DBG_MESSAGE(x, msg)
+#   define GHULBUS_PRECONDITION_DBG_MESSAGE(x, msg) GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(x)
 /** Production-level precondition check with custom message.
  * @copydetails GHULBUS_ASSERT
  */
@@ -107,8 +112,35 @@
 #   define GHULBUS_UNREACHABLE_MESSAGE(msg)         GHULBUS_INTERNAL_UNREACHABLE_IMPL(msg)
 #endif
 
+/** Hint to the optimizer that an expression evaluates to true.
+ * If the expression would evaluate to false, the behavior is undefined.
+ * The expression is never evaluated at runtime.
+ * GCC before version 13 cannot assume an expression without evaluating it. There, the hint only has an effect if
+ * the expression folds to a constant, like `GHULBUS_ASSUME(false)`, and is ignored otherwise.
+ */
+#if __has_cpp_attribute(assume) >= 202207L
+#   define GHULBUS_ASSUME(x) [[assume(x)]]
+#elif defined __clang__
+#   define GHULBUS_ASSUME(x) __builtin_assume(x)
+#elif defined _MSC_VER
+#   define GHULBUS_ASSUME(x) __assume(x)
+#elif defined __GNUC__
+#   define GHULBUS_ASSUME(x) ((__builtin_constant_p(!(x)) && !(x)) ? __builtin_unreachable() : static_cast<void>(0))
+#else
+#   define GHULBUS_ASSUME(x) static_cast<void>(0)
+#endif
+
 /** @cond
  */
+/* If GHULBUS_CONFIG_ASSUME_PRECONDITIONS is defined, disabled precondition checks are not removed, but turned
+ * into GHULBUS_ASSUME, so that the optimizer may rely on them. A violated precondition is then undefined behavior.
+ */
+#ifdef GHULBUS_CONFIG_ASSUME_PRECONDITIONS
+#   define GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(x) GHULBUS_ASSUME(x)
+#else
+#   define GHULBUS_INTERNAL_DISABLED_PRECONDITION_IMPL(x)
+#endif
+
 #if defined _MSC_VER
 #   define GHULBUS_INTERNAL_HELPER_FUNCTION __FUNCSIG__
 #elif defined __clang__
@@ -121,26 +153,42 @@
 
 #define GHULBUS_INTERNAL_HELPER_DUMMY_FOR_SEMICOLON (void)(0)
 
-#define GHULBUS_INTERNAL_SIGNAL_ASSERTION_FAILURE(cond, msg)                                                         \
-    ::GHULBUS_BASE_NAMESPACE::Assert::assertionFailed(                                                               \
-        ::GHULBUS_BASE_NAMESPACE::Assert::HandlerParameters{                                                         \
+#if defined __GNUC__ || defined __clang__
+#   define GHULBUS_INTERNAL_HELPER_COLD_FUNCTION [[gnu::cold, gnu::noinline]]
+#elif defined _MSC_VER
+#   define GHULBUS_INTERNAL_HELPER_COLD_FUNCTION __declspec(noinline)
+#else
+#   define GHULBUS_INTERNAL_HELPER_COLD_FUNCTION
+#endif
+
+/* The description of the assertion lives in a static Site, so that the failing branch only passes its address and
+ * the message to an out-of-line function.
+ */
+#define GHULBUS_INTERNAL_SIGNAL_FAILURE(failure_function, condition_string, msg)                                      \
+    {                                                                                                                \
+        static ::GHULBUS_BASE_NAMESPACE::Assert::Site ghulbus_internal_assert_site{                                  \
                                                     __FILE__,                                                        \
                                                     __LINE__,                                                        \
                                                     GHULBUS_INTERNAL_HELPER_FUNCTION,                                \
-                                                    #cond,                                                           \
-                                                    msg } );
+                                                    condition_string,                                                \
+                                                    {} };                                                            \
+        ::GHULBUS_BASE_NAMESPACE::Assert::failure_function(ghulbus_internal_assert_site, msg);                      \
+    }
+
+#define GHULBUS_INTERNAL_SIGNAL_ASSERTION_FAILURE(cond, msg)                                                         \
+    GHULBUS_INTERNAL_SIGNAL_FAILURE(assertionFailed, #cond, msg)
 
 
 #define GHULBUS_INTERNAL_ASSERT_IMPL(cond, msg)                                                                      \
-    if(!(cond)) {                                                                                                    \
+    if(!(cond)) [[unlikely]] {                                                                                       \
         GHULBUS_INTERNAL_SIGNAL_ASSERTION_FAILURE(cond, msg)                                                         \
     } GHULBUS_INTERNAL_HELPER_DUMMY_FOR_SEMICOLON                                                                    \
 
 
 #define GHULBUS_INTERNAL_PRECONDITION_IMPL(x, msg) GHULBUS_INTERNAL_ASSERT_IMPL(x, msg)
 
-#define GHULBUS_INTERNAL_UNREACHABLE_IMPL(msg) \
-    GHULBUS_INTERNAL_SIGNAL_ASSERTION_FAILURE(Unreachable_Code, msg)\
+#define GHULBUS_INTERNAL_UNREACHABLE_IMPL(msg)                                                                       \
+    GHULBUS_INTERNAL_SIGNAL_FAILURE(unreachableCodeReached, "Unreachable_Code", msg)                                 \
     GHULBUS_INTERNAL_HELPER_DUMMY_FOR_SEMICOLON
 /** @endcond
  */
@@ -150,6 +198,19 @@ namespace GHULBUS_BASE_NAMESPACE
     /** Assertion handling.
      */
     namespace Assert {
+        /** Static description of the location of an assertion.
+         * Every assertion macro defines a Site with static storage duration that is passed to assertionFailed() if
+         * the assertion fails, so that the code for the check itself stays small.
+         */
+        struct GHULBUS_BASE_API Site {
+            char const* file;                       //!< Name of the source file containing the assertion.
+            long        line;                       //!< Line in the source file containing the assertion.
+            char const* function;                   //!< Name of the function that contains the assertion.
+            char const* condition;                  //!< Textual representation of the asserted condition.
+            std::atomic<std::uint64_t> failures;    //!< Number of times the assertion failed.
+            std::atomic<std::uint64_t> logState{};  //!< Rate limiting state used by failLogAndContinue().
+        };
+
         /** Parameter passed to an assertion \ref Handler.
          */
         struct GHULBUS_BASE_API HandlerParameters {
@@ -158,25 +219,40 @@ namespace GHULBUS_BASE_NAMESPACE
             char const* function;           //!< Name of the function that contains the failing assertion.
             char const* condition;          //!< Textual representation of the condition that failed the assertion.
             char const* message;            //!< Optional user-provided description. NULL if none provided.
+            Site*       site = nullptr;     //!< Site of the failing assertion macro. NULL if not raised by a macro.
         };
 
         /** Assertion Handler signature.
          * Functions of this type can be registered with setAssertionHandler() to be invoked by assertionFailed().
-         * Assertion Handlers must not return to their caller once they have been invoked. If a handler does return,
-         * assertionFailed() will call std::abort() to avoid further undefined behavior.
+         * Assertion Handlers must not return to their caller once they have been invoked, unless they were
+         * registered with ReturnBehavior::Continue. If a handler does return otherwise, assertionFailed() will call
+         * std::abort() to avoid further undefined behavior.
          */
         using Handler = void(*)(HandlerParameters const&);
 
+        /** Determines what happens if an assertion handler returns.
+         */
+        enum class ReturnBehavior {
+            Abort,              ///< Call std::abort().
+            Continue            ///< Continue execution after the failing assertion macro.
+        };
+
         /** Determine the behavior in case of failing assertions.
          * The default assertion handler is failAbort().
          * @param[in] handler Function to be invoked by assertionFailed() in case of a failing assertion.
+         * @param[in] return_behavior Whether execution may continue after a failing assertion if the handler returns.
          */
-        GHULBUS_BASE_API void setAssertionHandler(Handler handler) noexcept;
+        GHULBUS_BASE_API void setAssertionHandler(Handler handler,
+                                                  ReturnBehavior return_behavior = ReturnBehavior::Abort) noexcept;
 
         /** Retrieve the current assertion handler.
          */
         GHULBUS_BASE_API Handler getAssertionHandler() noexcept;
 
+        /** Retrieve the return behavior of the current assertion handler.
+         */
+        GHULBUS_BASE_API ReturnBehavior getAssertionHandlerReturnBehavior() noexcept;
+
         /** Invoke the assertion handler.
          * This is called by the assert macros if an assertion fails. The active assertion handler can be changed
          * with setAssertionHandler().
@@ -184,6 +260,21 @@ namespace GHULBUS_BASE_NAMESPACE
          */
         [[noreturn]] GHULBUS_BASE_API void assertionFailed(HandlerParameters const& param);
 
+        /** Invoke the assertion handler for a failing assertion from an assertion macro.
+         * Increments the failure count of the site before invoking the assertion handler. Returns only if the
+         * handler returns and was registered with ReturnBehavior::Continue.
+         * @param[in] site Location of the failing assertion.
+         * @param[in] message Optional user-provided description. NULL if none provided.
+         */
+        GHULBUS_INTERNAL_HELPER_COLD_FUNCTION GHULBUS_BASE_API
+        void assertionFailed(Site& site, char const* message);
+
+        /** Invoke the assertion handler for unreachable code.
+         * Same as assertionFailed(), but execution never continues, regardless of the ReturnBehavior.
+         */
+        [[noreturn]] GHULBUS_INTERNAL_HELPER_COLD_FUNCTION GHULBUS_BASE_API
+        void unreachableCodeReached(Site& site, char const* message);
+
         /** Assertion handler that calls std::abort().
          * This is the default assertion handler. It writes an error message to cerr and calls abort.
          */
@@ -200,6 +291,21 @@ namespace GHULBUS_BASE_NAMESPACE
          * The locational information of that exception will point to the location where the failing exception occured.
          */
         [[noreturn]] GHULBUS_BASE_API void failThrow(HandlerParameters const& param);
+
+        /** Assertion handler that logs the failure and returns.
+         * This handler has to be registered with ReturnBehavior::Continue. It is intended for canary deployments,
+         * where violations should be recorded without taking down the process.
+         * The first failure of every assertion is logged with LogLevel::Error through the Log subsystem. Further
+         * failures of the same assertion are logged at most as often per minute as set with
+         * setLogAndContinueRateLimit(), the rest is only counted in Site::failures. Rate limiting is lock-free.
+         * Logging has to be initialized while this handler is active.
+         */
+        GHULBUS_BASE_API void failLogAndContinue(HandlerParameters const& param);
+
+        /** Set the maximum number of times per minute that failLogAndContinue() logs the failure of an assertion.
+         * The default is 10.
+         */
+        GHULBUS_BASE_API void setLogAndContinueRateLimit(std::uint32_t max_logs_per_minute) noexcept;
     }
 }
 
@@ -0,0 +1,314 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_CHANNEL_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_CHANNEL_HPP
+
+/** @file
+ *
+ * @brief Bounded multi-producer multi-consumer channel.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+/** A bounded, thread-safe queue for passing values between threads.
+ * Any number of threads may push to and pop from the same channel concurrently.
+ * Elements are stored in a fixed ring of slots that is allocated on construction. Each slot carries a sequence
+ * number that tells producers and consumers whether it is currently free or occupied, so that all operations
+ * on a channel that is neither empty nor full complete without locking.
+ * Threads only block if the channel is empty (consumers) or full (producers). Blocked threads are parked
+ * using `std::atomic::wait` and will only be notified if somebody is actually waiting.
+ *
+ * A channel can be closed with close(). After that, all push operations fail, while pop operations continue
+ * to succeed until the channel has been drained.
+ */
+template<typename T>
+class Channel {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Channel elements must be nothrow move constructible.");
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+private:
+    static constexpr std::size_t cache_line_size = 64;
+
+    /** A slot is free for the push at position `pos` if its sequence is `2*pos` and holds the element for the
+     * pop at position `pos` if its sequence is `2*pos + 1`.
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* get() noexcept {
+            return std::launder(reinterpret_cast<T*>(&storage));
+        }
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_type m_capacity;
+    alignas(cache_line_size) std::atomic<std::uint64_t> m_pushPosition;
+    alignas(cache_line_size) std::atomic<std::uint64_t> m_popPosition;
+    alignas(cache_line_size) std::atomic<std::uint32_t> m_pushedSignal;     ///< consumers wait on this
+    std::atomic<std::uint32_t> m_waitingConsumers;
+    alignas(cache_line_size) std::atomic<std::uint32_t> m_poppedSignal;     ///< producers wait on this
+    std::atomic<std::uint32_t> m_waitingProducers;
+    std::atomic<bool> m_isClosed;
+public:
+    /** Constructor.
+     * @param[in] capacity Maximum number of elements that can be stored in the channel at once.
+     * \pre capacity > 0
+     */
+    explicit Channel(size_type capacity)
+        :m_slots(std::make_unique<Slot[]>(capacity)), m_capacity(capacity), m_pushPosition(0), m_popPosition(0),
+         m_pushedSignal(0), m_waitingConsumers(0), m_poppedSignal(0), m_waitingProducers(0), m_isClosed(false)
+    {
+        GHULBUS_PRECONDITION(capacity > 0);
+        for (size_type i = 0; i < capacity; ++i) {
+            m_slots[i].sequence.store(2 * i, std::memory_order_relaxed);
+        }
+    }
+
+    /** Destructor.
+     * Elements remaining in the channel are destroyed.
+     * \pre No thread is accessing the channel.
+     */
+    ~Channel()
+    {
+        while (try_pop()) {}
+    }
+
+    Channel(Channel const&) = delete;
+    Channel& operator=(Channel const&) = delete;
+
+    /** Attempts to push an element without blocking.
+     * @return true if the element was pushed; false if the channel is full or closed.
+     *         If the push fails, `v` is left untouched, unless `v` is an rvalue and constructing a `T` from it may
+     *         throw. In that case the element is constructed before the push is attempted, so `v` may have been
+     *         moved from even though false is returned.
+     */
+    template<typename TT>
+    bool try_push(TT&& v)
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, TT&&>) {
+            return tryPushImpl(std::forward<TT>(v));
+        } else {
+            // construct outside of the slot, so that an exception cannot leave a claimed slot behind
+            if (isFull()) { return false; }
+            T tmp(std::forward<TT>(v));
+            return tryPushImpl(std::move(tmp));
+        }
+    }
+
+    /** Pushes an element, blocking while the channel is full.
+     * @return true if the element was pushed; false if the channel was closed.
+     */
+    template<typename TT>
+    bool push(TT&& v)
+    {
+        T tmp(std::forward<TT>(v));
+        for (;;) {
+            if (tryPushImpl(std::move(tmp))) { return true; }
+            if (closed()) { return false; }
+            m_waitingProducers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::uint32_t const signal = m_poppedSignal.load(std::memory_order_acquire);
+            if (!isFull() || closed()) {
+                m_waitingProducers.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            m_poppedSignal.wait(signal, std::memory_order_acquire);
+            m_waitingProducers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** Attempts to pop an element without blocking.
+     * @return The front element of the channel or `std::nullopt` if the channel is empty.
+     */
+    std::optional<T> try_pop()
+    {
+        std::optional<T> ret;
+        std::uint64_t pos = m_popPosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos % m_capacity];
+            std::uint64_t const seq = slot->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::int64_t>(seq - (2 * pos + 1));
+            if (diff == 0) {
+                if (m_popPosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+            } else if (diff < 0) {
+                return ret;
+            } else {
+                pos = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+        ret.emplace(std::move(*slot->get()));
+        slot->get()->~T();
+        slot->sequence.store(2 * (pos + m_capacity), std::memory_order_release);
+        signalWaiting(m_waitingProducers, m_poppedSignal);
+        return ret;
+    }
+
+    /** Pops an element, blocking while the channel is empty.
+     * @return The front element of the channel or `std::nullopt` if the channel was closed and is empty.
+     */
+    std::optional<T> pop()
+    {
+        for (;;) {
+            if (auto ret = try_pop(); ret) { return ret; }
+            if (closed()) { return try_pop(); }
+            m_waitingConsumers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::uint32_t const signal = m_pushedSignal.load(std::memory_order_acquire);
+            if (!isEmpty() || closed()) {
+                m_waitingConsumers.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            m_pushedSignal.wait(signal, std::memory_order_acquire);
+            m_waitingConsumers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** Pops an element, blocking for at most the given amount of time while the channel is empty.
+     * @return The front element of the channel or `std::nullopt` if the channel remained empty.
+     * @note As `std::atomic::wait` does not support timeouts, this function polls the channel with
+     *       exponential backoff. Prefer pop() where no timeout is required.
+     */
+    template<typename Rep, typename Period>
+    std::optional<T> pop_for(std::chrono::duration<Rep, Period> const& timeout)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        std::chrono::microseconds backoff(1);
+        for (;;) {
+            if (auto ret = try_pop(); ret) { return ret; }
+            if (closed()) { return try_pop(); }
+            auto const now = std::chrono::steady_clock::now();
+            if (now >= deadline) { return std::nullopt; }
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(backoff, deadline - now));
+            backoff = std::min(backoff * 2, std::chrono::microseconds(1000));
+        }
+    }
+
+    /** Pops up to `max_elements` elements, blocking while the channel is empty.
+     * Blocks until at least one element is available, then pops all available elements up to the given limit.
+     * @param[out] out Output iterator receiving the popped elements.
+     * @param[in] max_elements Maximum number of elements to pop.
+     * @return Number of popped elements. This is 0 only if the channel was closed and is empty.
+     */
+    template<typename OutputIterator>
+    size_type pop_batch(OutputIterator out, size_type max_elements)
+    {
+        if (max_elements == 0) { return 0; }
+        auto first = pop();
+        if (!first) { return 0; }
+        *out++ = std::move(*first);
+        size_type n_popped = 1;
+        for (; n_popped < max_elements; ++n_popped) {
+            auto next = try_pop();
+            if (!next) { break; }
+            *out++ = std::move(*next);
+        }
+        return n_popped;
+    }
+
+    /** Closes the channel.
+     * All blocked producers and consumers are woken up. Subsequent push operations will fail.
+     * Elements still in the channel can be popped until the channel is empty.
+     * @note Push operations that are executing concurrently with close() may still succeed.
+     */
+    void close()
+    {
+        m_isClosed.store(true, std::memory_order_seq_cst);
+        m_pushedSignal.fetch_add(1, std::memory_order_release);
+        m_pushedSignal.notify_all();
+        m_poppedSignal.fetch_add(1, std::memory_order_release);
+        m_poppedSignal.notify_all();
+    }
+
+    /** Checks whether close() has been called.
+     */
+    bool closed() const noexcept
+    {
+        return m_isClosed.load(std::memory_order_acquire);
+    }
+
+    /** Checks whether the channel is empty.
+     * If other threads access the channel concurrently, the result may be outdated by the time it is returned.
+     */
+    bool empty() const noexcept
+    {
+        return isEmpty();
+    }
+
+    /** Maximum number of elements that can be stored in the channel at once.
+     */
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+private:
+    template<typename TT>
+    bool tryPushImpl(TT&& v)
+    {
+        if (closed()) { return false; }
+        std::uint64_t pos = m_pushPosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[pos % m_capacity];
+            std::uint64_t const seq = slot->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::int64_t>(seq - 2 * pos);
+            if (diff == 0) {
+                if (m_pushPosition.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+        new (&slot->storage) T(std::forward<TT>(v));
+        slot->sequence.store(2 * pos + 1, std::memory_order_release);
+        signalWaiting(m_waitingConsumers, m_pushedSignal);
+        return true;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        std::uint64_t const pos = m_popPosition.load(std::memory_order_relaxed);
+        return m_slots[pos % m_capacity].sequence.load(std::memory_order_acquire) != 2 * pos + 1;
+    }
+
+    bool isFull() const noexcept
+    {
+        std::uint64_t const pos = m_pushPosition.load(std::memory_order_relaxed);
+        return m_slots[pos % m_capacity].sequence.load(std::memory_order_acquire) != 2 * pos;
+    }
+
+    /** Wakes up one thread parked on signal, if there are any.
+     * The fence pairs with the one in the waiting thread: Either the waiting thread sees the element that was
+     * just pushed or popped, or we see the waiting counter and notify. A waiting thread that already observes
+     * the incremented signal also observes the element, as it loads the signal with acquire semantics.
+     */
+    static void signalWaiting(std::atomic<std::uint32_t>& waiting, std::atomic<std::uint32_t>& signal)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) > 0) {
+            signal.fetch_add(1, std::memory_order_release);
+            signal.notify_one();
+        }
+    }
+};
+
+}
+
+#endif
@@ -8,13 +8,39 @@
  */
 #include <gbBase/config.hpp>
 
+#ifdef GHULBUS_CONFIG_EXCEPTION_THROW_TELEMETRY
+#   include <gbBase/ExceptionTelemetry.hpp>
+#endif
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
+#include <new>
 #include <optional>
-#include <sstream>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <typeinfo>
 #include <type_traits>
+#include <utility>
+
+/** @cond
+ */
+#if defined _MSC_VER
+#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __FUNCSIG__
+#elif defined __clang__
+#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __PRETTY_FUNCTION__
+#elif defined __GNUC__
+#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __PRETTY_FUNCTION__
+#else
+#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __func__
+#endif
+/** @endcond
+ */
 
 namespace GHULBUS_BASE_NAMESPACE
 {
@@ -55,15 +81,6 @@ namespace GHULBUS_BASE_NAMESPACE
     namespace impl {
     /** @cond
      */
-    /** Helper functor for converting arbitrary types to string for printing.
-     * - if `T` is std::string acts as the identity function
-     * - if `T` has an overload of `to_string` found through an unqualified call, uses `to_string`
-     * - if `T` has an ostream inserter defined, uses `operator<<` to insert to a `std::stringstream`
-     * - otherwise use `typeid(T).name()`.
-     */
-    template<typename T, typename = void>
-    struct toStringHelper;
-
     using std::to_string;
 
     template<typename T, typename = void>
@@ -74,45 +91,339 @@ namespace GHULBUS_BASE_NAMESPACE
     template<typename T, typename = void>
     struct hasOstreamInserter : public std::false_type {};
     template<typename T>
-    struct hasOstreamInserter<T, std::void_t<decltype(std::declval<std::stringstream>() << std::declval<T>())>> : public std::true_type {};
+    struct hasOstreamInserter<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<T>())>> : public std::true_type {};
+
+    /** Stream buffer that appends all output to a std::string.
+     */
+    class StringAppendBuffer : public std::streambuf {
+    private:
+        std::string* m_out;
+    public:
+        explicit StringAppendBuffer(std::string& out) noexcept
+            :m_out(&out)
+        {}
+    protected:
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                m_out->push_back(traits_type::to_char_type(c));
+            }
+            return traits_type::not_eof(c);
+        }
 
-    template<>
-    struct toStringHelper<std::string> {
-        std::string const& operator()(std::string const& s) {
-            return s;
+        std::streamsize xsputn(char const* s, std::streamsize n) override {
+            m_out->append(s, static_cast<std::size_t>(n));
+            return n;
         }
     };
 
+    /** Appends a printable representation of a value to `out`.
+     * - if `T` is std::string or std::string_view, appends the string
+     * - if `T` is an arithmetic type, uses `std::to_chars`
+     * - if `T` has an overload of `to_string` found through an unqualified call, uses `to_string`
+     * - if `T` has an ostream inserter defined, uses `operator<<` to insert directly into `out`
+     * - otherwise uses `typeid(T).name()`.
+     */
     template<typename T>
-    struct toStringHelper<T, std::enable_if_t<!std::is_same_v<T, std::string> && hasToString<T>::value>> {
-        std::string operator()(T const& v) {
-            return to_string(v);
+    void appendDataString(T const& v, std::string& out) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            out.append(v);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            out.append(1, v ? '1' : '0');
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            char buffer[64];
+            out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), v).ptr);
+        } else if constexpr (hasToString<T>::value) {
+            out.append(to_string(v));
+        } else if constexpr (hasOstreamInserter<T>::value) {
+            StringAppendBuffer buffer(out);
+            std::ostream os(&buffer);
+            os << v;
+        } else {
+            out.append(typeid(T).name());
         }
-    };
+    }
 
+    /** Estimated number of characters appended by appendDataString().
+     */
     template<typename T>
-    struct toStringHelper<T, std::enable_if_t<!std::is_same_v<T, std::string> &&
-                                              !hasToString<T>::value &&
-                                              hasOstreamInserter<T>::value>>
-    {
-        std::string operator()(T const& v) {
-            std::stringstream sstr;
-            sstr << v;
-            return sstr.str();
+    std::size_t dataStringSizeHint(T const& v) noexcept {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            return v.size();
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return 24;
+        } else {
+            return 32;
         }
-    };
+    }
 
-    template<typename T>
-    struct toStringHelper<T, std::enable_if_t<!std::is_same_v<T, std::string> &&
-                                              !hasToString<T>::value &&
-                                              !hasOstreamInserter<T>::value>>
-    {
-        std::string operator()(T const& v) {
-            return typeid(T).name();
+    /** Guards the lazy initialization of a cached value in an object that may be inspected by several threads.
+     * The first thread that calls callOnce() runs the initialization, concurrent callers wait until it is done.
+     * If the initialization throws, the next caller retries it.
+     * Copies start out uninitialized.
+     */
+    class LazyInitFlag {
+    private:
+        static constexpr std::uint32_t uninitialized = 0;
+        static constexpr std::uint32_t initializing = 1;
+        static constexpr std::uint32_t initialized = 2;
+
+        std::atomic<std::uint32_t> m_state;
+    public:
+        LazyInitFlag() noexcept
+            :m_state(uninitialized)
+        {}
+
+        LazyInitFlag(LazyInitFlag const&) noexcept
+            :m_state(uninitialized)
+        {}
+
+        LazyInitFlag& operator=(LazyInitFlag const&) noexcept {
+            reset();
+            return *this;
+        }
+
+        template<typename F>
+        void callOnce(F&& f) {
+            std::uint32_t state = m_state.load(std::memory_order_acquire);
+            while (state != initialized) {
+                if (state == initializing) {
+                    m_state.wait(initializing, std::memory_order_acquire);
+                    state = m_state.load(std::memory_order_acquire);
+                } else if (m_state.compare_exchange_weak(state, initializing, std::memory_order_acquire)) {
+                    try {
+                        std::forward<F>(f)();
+                    } catch (...) {
+                        finish(uninitialized);
+                        throw;
+                    }
+                    finish(initialized);
+                    return;
+                }
+            }
+        }
+
+        /** \pre No other thread is accessing the flag.
+         */
+        void reset() noexcept {
+            m_state.store(uninitialized, std::memory_order_relaxed);
+        }
+    private:
+        void finish(std::uint32_t state) noexcept {
+            m_state.store(state, std::memory_order_release);
+            m_state.notify_all();
         }
     };
     /** @endcond
     */
+
+    /** Compile-time ID for a decorator type.
+     * The ID is the 64-bit FNV-1a hash of the signature of an instantiation of this function template. IDs can be
+     * compared with a single integer comparison, but they are not unique: types with the same name in anonymous
+     * namespaces of different translation units get the same ID, and different names may collide. A matching ID
+     * therefore always has to be confirmed by comparing the `std::type_info` of the decorator.
+     */
+    template<typename Tag_T, typename T>
+    consteval std::uint64_t errorInfoId() noexcept {
+        std::string_view const signature = GHULBUS_INTERNAL_HELPER_FUNCTION_2;
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : signature) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /** Storage for the ErrorInfo decorators of an exception.
+     * Decorators are stored back to back in a single block of memory. Up to `inline_capacity` bytes are stored
+     * inline, so that decorating an exception with a few small decorators does not allocate. Only once the inline
+     * buffer overflows, all decorators are moved to a heap block that grows geometrically.
+     * Heap blocks are reference counted and shared between copies, so that copying an exception that is passed
+     * around, e.g. through a `std::exception_ptr`, does not copy its decorators. Adding a decorator to a shared
+     * block copies the block first.
+     * Values that are not nothrow move constructible are boxed on the heap individually, so that the block
+     * can always be relocated without throwing.
+     */
+    class GHULBUS_BASE_API ErrorInfoStorage {
+    public:
+        struct VTable {
+            std::uint64_t id;
+            std::type_info const* tag;
+            std::type_info const* value;
+            void (*copy)(void* dst, void const* src);
+            void (*relocate)(void* dst, void* src) noexcept;
+            void (*destroy)(void* p) noexcept;
+            void (*appendDataString)(void const* p, std::string& out);
+            std::size_t (*dataStringSizeHint)(void const* p) noexcept;
+        };
+
+        static constexpr std::size_t inline_capacity = 128;
+        static constexpr std::size_t index_capacity = 8;
+    private:
+        static constexpr std::size_t entry_alignment = alignof(std::max_align_t);
+
+        static constexpr std::size_t alignEntrySize(std::size_t s) noexcept {
+            return (s + entry_alignment - 1) / entry_alignment * entry_alignment;
+        }
+
+        struct Header {
+            VTable const* vtable;
+            std::size_t size;       ///< Size of the entry in bytes, including the header.
+        };
+
+        /** Index entry pointing to the most recently added decorator with a given ID.
+         */
+        struct IndexEntry {
+            std::uint64_t id;
+            std::size_t offset;     ///< Offset of the value in the storage block.
+        };
+
+        static constexpr std::size_t header_size =
+            (sizeof(Header) + entry_alignment - 1) / entry_alignment * entry_alignment;
+
+        template<typename T>
+        struct Model {
+            static constexpr bool is_boxed =
+                !std::is_nothrow_move_constructible_v<T> || (alignof(T) > entry_alignment);
+            using Stored = std::conditional_t<is_boxed, T*, T>;
+
+            static T const& get(void const* p) noexcept {
+                if constexpr (is_boxed) {
+                    return **std::launder(static_cast<T* const*>(p));
+                } else {
+                    return *std::launder(static_cast<T const*>(p));
+                }
+            }
+
+            template<typename... Args>
+            static void construct(void* p, Args&&... args) {
+                if constexpr (is_boxed) {
+                    ::new(p) Stored(new T(std::forward<Args>(args)...));
+                } else {
+                    ::new(p) T(std::forward<Args>(args)...);
+                }
+            }
+
+            static void copy(void* dst, void const* src) {
+                construct(dst, get(src));
+            }
+
+            static void relocate(void* dst, void* src) noexcept {
+                Stored& s = *std::launder(static_cast<Stored*>(src));
+                ::new(dst) Stored(std::move(s));
+                s.~Stored();
+            }
+
+            static void destroy(void* p) noexcept {
+                if constexpr (is_boxed) {
+                    delete &get(p);
+                } else {
+                    std::launder(static_cast<T*>(p))->~T();
+                }
+            }
+
+            static void appendDataString(void const* p, std::string& out) {
+                impl::appendDataString(get(p), out);
+            }
+
+            static std::size_t dataStringSizeHint(void const* p) noexcept {
+                return impl::dataStringSizeHint(get(p));
+            }
+        };
+
+        alignas(std::max_align_t) std::byte m_inline[inline_capacity];
+        std::byte* m_heap = nullptr;       ///< Shared block; decorators in it are never modified after being added.
+        std::size_t m_capacity = inline_capacity;
+        std::size_t m_size = 0;
+        /// Sorted by ID. Once more than index_capacity different decorators are stored, the index is abandoned.
+        IndexEntry m_index[index_capacity];
+        std::size_t m_indexSize = 0;
+        bool m_indexOverflow = false;
+    public:
+        ErrorInfoStorage() noexcept = default;
+        ~ErrorInfoStorage();
+        ErrorInfoStorage(ErrorInfoStorage const& rhs);
+        ErrorInfoStorage& operator=(ErrorInfoStorage const& rhs);
+        ErrorInfoStorage(ErrorInfoStorage&& rhs) noexcept;
+        ErrorInfoStorage& operator=(ErrorInfoStorage&& rhs) noexcept;
+
+        /** Appends a decorator of type `TagType` with value `value`.
+         */
+        template<typename TagType, typename T, typename U>
+        void add(U&& value) {
+            using M = Model<T>;
+            static constexpr VTable vtable{ errorInfoId<TagType, T>(), &typeid(TagType), &typeid(T),
+                                            &M::copy, &M::relocate, &M::destroy, &M::appendDataString,
+                                            &M::dataStringSizeHint };
+            std::size_t const entry_size = entrySize<T>();
+            void* p = reserve(entry_size);
+            M::construct(p, std::forward<U>(value));
+            commit(&vtable, entry_size);
+        }
+
+        /** Number of bytes a decorator with a value of type `T` occupies in the storage.
+         */
+        template<typename T>
+        static constexpr std::size_t entrySize() noexcept {
+            return header_size + alignEntrySize(sizeof(typename Model<T>::Stored));
+        }
+
+        /** Retrieves the value of the most recently added decorator of type `TagType`.
+         * @return A pointer to the value or nullptr if there is no such decorator.
+         */
+        template<typename TagType, typename T>
+        T const* find() const {
+            void const* p = find(errorInfoId<TagType, T>(), typeid(TagType), typeid(T));
+            return p ? &Model<T>::get(p) : nullptr;
+        }
+
+        /** Retrieves the address of the value of the most recently added decorator with the given ID and types.
+         */
+        void const* find(std::uint64_t id, std::type_info const& tag, std::type_info const& value) const noexcept;
+
+        /** Invokes f(VTable const&, void const* data) for every decorator in the order they were added.
+         */
+        template<typename F>
+        void forEach(F&& f) const {
+            std::byte const* const base = data();
+            for (std::size_t offset = 0; offset < m_size;) {
+                Header const& h = *std::launder(reinterpret_cast<Header const*>(base + offset));
+                f(*h.vtable, base + offset + header_size);
+                offset += h.size;
+            }
+        }
+
+        /** Total size of all stored decorators in bytes.
+         */
+        std::size_t sizeInBytes() const noexcept {
+            return m_size;
+        }
+
+        bool isInline() const noexcept {
+            return m_heap == nullptr;
+        }
+
+        /** Whether the decorators are shared with a copy of this storage.
+         */
+        bool isShared() const noexcept;
+    private:
+        std::byte* data() noexcept {
+            return m_heap ? m_heap : m_inline;
+        }
+
+        std::byte const* data() const noexcept {
+            return m_heap ? m_heap : m_inline;
+        }
+
+        /** Ensures there is room for an entry of the given size at the end and returns the address of its value.
+         */
+        void* reserve(std::size_t entry_size);
+        void commit(VTable const* vtable, std::size_t entry_size) noexcept;
+        void addToIndex(std::uint64_t id, std::size_t offset) noexcept;
+        void releaseHeap() noexcept;
+        void destroyEntries(std::byte* base) noexcept;
+        void clear() noexcept;
+        void copyFrom(ErrorInfoStorage const& rhs);
+        void moveFrom(ErrorInfoStorage& rhs) noexcept;
+    };
     }
 
     /** Exception decorators.
@@ -129,7 +440,9 @@ namespace GHULBUS_BASE_NAMESPACE
         {
             struct GHULBUS_BASE_API location { };
             struct GHULBUS_BASE_API description { };
+            struct GHULBUS_BASE_API static_description { };
             struct GHULBUS_BASE_API filename { };
+            struct GHULBUS_BASE_API stack_trace { };
         }
         /** Decorator record types.
          */
@@ -144,6 +457,19 @@ namespace GHULBUS_BASE_NAMESPACE
                     :file(nfile), function(nfunc), line(nline)
                 {}
             };
+
+            /** Raw return addresses of a call stack, innermost frame first.
+             * Symbol names are only resolved when the stack trace is converted to a string.
+             * The number of frames is limited so that a stack trace fits into the inline decorator storage of an
+             * exception, and decorating an exception with it does not allocate.
+             */
+            struct stack_trace {
+                static constexpr std::size_t max_frames = 13;
+                void* frames[max_frames];
+                std::size_t size;
+            };
+
+            GHULBUS_BASE_API std::string to_string(stack_trace const& st);
         }
 
         /** @name Decorators
@@ -155,11 +481,41 @@ namespace GHULBUS_BASE_NAMESPACE
         /** A user-provided string describing the error.
          */
         using description = ErrorInfo<Tags::description, std::string>;
+        /** A description referring to a string with static storage duration, like a string literal.
+         * The string is not copied. It can be retrieved through either this decorator or `description`.
+         */
+        using static_description = ErrorInfo<Tags::static_description, std::string_view>;
         /** A filename for errors occurring in the context of a file operation.
          */
         using filename = ErrorInfo<Tags::filename, std::string>;
+        /** The call stack at the throw site.
+         * Attached by \ref GHULBUS_THROW if `GHULBUS_CONFIG_EXCEPTION_STACK_TRACES` is defined and stack trace
+         * capture has not been disabled at runtime with setStackTraceCaptureEnabled().
+         */
+        using stack_trace = ErrorInfo<Tags::stack_trace, Records::stack_trace>;
         /// @}
     }
+    static_assert(impl::ErrorInfoStorage::entrySize<Exception_Info::Records::stack_trace>() <=
+                  impl::ErrorInfoStorage::inline_capacity, "Stack traces must fit into the inline decorator storage.");
+
+    /** Captures the return addresses of the current call stack.
+     * This only copies raw addresses and does not resolve any symbols.
+     * On x86-64 and AArch64 Linux, the addresses are collected by walking the chain of frame pointers, which
+     * neither allocates nor takes any locks. Frames of code that was compiled without frame pointers
+     * (`-fno-omit-frame-pointer`) end the trace early. The bounds of the stack are looked up once per thread, on
+     * the first capture in that thread. On Windows, `RtlCaptureStackBackTrace` is used; on other platforms,
+     * `backtrace()`, which unwinds using the DWARF information of the binary and may allocate on first use.
+     * @param[in] skip_frames Number of innermost frames to omit, not counting the frame of this function.
+     */
+    GHULBUS_BASE_API Exception_Info::Records::stack_trace captureStackTrace(std::size_t skip_frames = 0) noexcept;
+
+    /** Enables or disables capturing of stack traces by \ref GHULBUS_THROW at runtime.
+     * Capturing is enabled by default, but only takes place if `GHULBUS_CONFIG_EXCEPTION_STACK_TRACES` is defined
+     * where \ref GHULBUS_THROW is used.
+     */
+    GHULBUS_BASE_API void setStackTraceCaptureEnabled(bool enabled) noexcept;
+
+    GHULBUS_BASE_API bool isStackTraceCaptureEnabled() noexcept;
 
     /** Base class for all Ghulbus exceptions.
      * Any exception can be decorated with additional info. Instantiate an Info object from the
@@ -173,72 +529,14 @@ namespace GHULBUS_BASE_NAMESPACE
      */
     class GHULBUS_BASE_API Exception : public virtual std::exception {
     private:
-        /** Type-erased storage for ErrorInfo (base class).
-         */
-        class ErrorInfoConcept {
-        private:
-            std::unique_ptr<ErrorInfoConcept> m_next;
-        public:
-            ErrorInfoConcept() = default;
-
-            explicit ErrorInfoConcept(std::unique_ptr<ErrorInfoConcept>&& next)
-                :m_next(std::move(next))
-            {}
-
-            virtual ~ErrorInfoConcept() noexcept = default;
-            virtual std::unique_ptr<ErrorInfoConcept> clone() const = 0;
-            virtual std::type_info const& getTypeInfo() const = 0;
-            virtual std::string dataString() const = 0;
-
-            ErrorInfoConcept const* next() const {
-                return m_next.get();
-            }
-
-            ErrorInfoConcept* next() {
-                return m_next.get();
-            }
-        };
-
-        /** Type-erased storage for ErrorInfo.
-        */
-        template<typename ErrorInfo_T>
-        class ErrorInfoModel : public ErrorInfoConcept {
-        public:
-            static_assert(IsErrorInfo<ErrorInfo_T>::value,
-                          "Only ErrorInfo types can be used to decorate Exception.");
-            using ValueType = typename ErrorInfo_T::ValueType;
-            using TagType = typename ErrorInfo_T::TagType;
-        private:
-            ValueType m_data;
-        public:
-            ErrorInfoModel(std::unique_ptr<ErrorInfoConcept>&& next, ErrorInfo_T data)
-                :ErrorInfoConcept(std::move(next)), m_data(std::move(data).getData())
-            {}
-
-            ~ErrorInfoModel() noexcept override = default;
-
-            std::unique_ptr<ErrorInfoConcept> clone() const override {
-                ErrorInfoConcept const* next_ei = next();
-                return std::make_unique<ErrorInfoModel>((next_ei == nullptr) ? nullptr : next_ei->clone(), m_data);
-            }
-
-            std::type_info const& getTypeInfo() const override {
-                return typeid(TagType);
-            }
-
-            ValueType const& data() const {
-                return m_data;
-            }
-
-            std::string dataString() const override {
-                return impl::toStringHelper<decltype(data())>{}(data());
-            }
-        };
-
-        std::unique_ptr<ErrorInfoConcept> mutable m_errorInfos;
+        mutable impl::ErrorInfoStorage m_errorInfos;
         mutable Exception_Info::Records::location m_location = Exception_Info::Records::location(nullptr, nullptr, -1);
         mutable std::string m_description;
+        /// Set if the description was given as static_description; m_description then only holds a copy on demand.
+        mutable std::string_view m_staticDescription;
+        mutable impl::LazyInitFlag m_staticDescriptionCopied;
         mutable std::string m_diagnosticMessageCached;
+        mutable impl::LazyInitFlag m_diagnosticMessageBuilt;     ///< reset if the message needs to be rebuilt
     protected:
         Exception() = default;
         virtual ~Exception() = default;
@@ -247,15 +545,23 @@ namespace GHULBUS_BASE_NAMESPACE
         Exception& operator=(Exception&&) noexcept  = default;
 
         Exception(Exception const& rhs)
-            :m_errorInfos((rhs.m_errorInfos == nullptr) ? nullptr : rhs.m_errorInfos->clone()),
-             m_location(rhs.m_location), m_description(rhs.m_description)
+            :m_errorInfos(rhs.m_errorInfos), m_location(rhs.m_location),
+             m_description(rhs.m_staticDescription.data() ? std::string() : rhs.m_description),
+             m_staticDescription(rhs.m_staticDescription)
         {}
 
         Exception& operator=(Exception const& rhs) {
             if (&rhs != this) {
-                m_errorInfos = ((rhs.m_errorInfos  == nullptr) ? nullptr : rhs.m_errorInfos->clone());
+                m_errorInfos = rhs.m_errorInfos;
                 m_location = rhs.m_location;
-                m_description = rhs.m_description;
+                if (rhs.m_staticDescription.data()) {
+                    m_description.clear();
+                } else {
+                    m_description = rhs.m_description;
+                }
+                m_staticDescription = rhs.m_staticDescription;
+                m_staticDescriptionCopied.reset();
+                m_diagnosticMessageBuilt.reset();
             }
             return *this;
         }
@@ -271,13 +577,15 @@ namespace GHULBUS_BASE_NAMESPACE
         template<typename ErrorInfo_T>
         std::enable_if_t<IsErrorInfo<std::decay_t<ErrorInfo_T>>::value, void>
         addErrorInfo(ErrorInfo_T&& error_info) const {
-            m_errorInfos = std::make_unique<
-                ErrorInfoModel<std::decay_t<ErrorInfo_T>>>(std::move(m_errorInfos),
-                                                           std::forward<ErrorInfo_T>(error_info));
+            using Info = std::decay_t<ErrorInfo_T>;
+            m_errorInfos.add<typename Info::TagType, typename Info::ValueType>(
+                std::forward<ErrorInfo_T>(error_info).getData());
+            m_diagnosticMessageBuilt.reset();
         }
 
         void setExceptionLocation(Exception_Info::Records::location const& location) const {
             m_location = location;
+            m_diagnosticMessageBuilt.reset();
         }
 
         Exception_Info::Records::location const& getLocation() const {
@@ -286,44 +594,52 @@ namespace GHULBUS_BASE_NAMESPACE
 
         void setDescription(std::string description) const {
             m_description = std::move(description);
+            m_staticDescription = {};
+            m_staticDescriptionCopied.reset();
+            m_diagnosticMessageBuilt.reset();
         }
 
+        void setStaticDescription(std::string_view description) const {
+            m_description.clear();
+            m_staticDescription = description;
+            m_staticDescriptionCopied.reset();
+            m_diagnosticMessageBuilt.reset();
+        }
+
+        /** A static description is only copied to a std::string when it is requested as one.
+         * This may happen concurrently from several threads inspecting the same exception object.
+         */
         std::string const& getDescription() const {
+            if (m_staticDescription.data()) {
+                m_staticDescriptionCopied.callOnce([this]() { m_description.assign(m_staticDescription); });
+            }
             return m_description;
         }
 
+        std::string_view const* getStaticDescription() const {
+            return m_staticDescription.data() ? &m_staticDescription : nullptr;
+        }
+
+        std::string_view getDescriptionView() const noexcept {
+            return m_staticDescription.data() ? m_staticDescription : std::string_view(m_description);
+        }
+
         template<typename ErrorInfo_T>
         typename ErrorInfo_T::ValueType const* getErrorInfo() const {
-            using TagType = typename ErrorInfo_T::TagType;
-            for (ErrorInfoConcept const* it = m_errorInfos.get(); it != nullptr; it = it->next()) {
-                if (it->getTypeInfo() == typeid(TagType)) {
-                    return &dynamic_cast<ErrorInfoModel<ErrorInfo_T> const&>(*it).data();
-                }
-            }
-            return nullptr;
+            static_assert(IsErrorInfo<ErrorInfo_T>::value, "Only ErrorInfo types can be used to decorate Exception.");
+            return m_errorInfos.find<typename ErrorInfo_T::TagType, typename ErrorInfo_T::ValueType>();
         }
 
+        /** The message is built on first use and cached until the exception is decorated again.
+         * Threads inspecting the same exception object concurrently build the message only once.
+         */
         char const* getDiagnosticMessage() const {
-            /*
-            <file>(<line>): Throw in function <func>
-            Dynamic exception type: bla
-            [<TagType #1>] = <data #1>
-             ...
-            [<TagType #n>] = <data #n>
-            */
-            m_diagnosticMessageCached =
-                std::string((m_location.file) ? m_location.file : "<unknown file>") +
-                '(' + std::to_string(m_location.line) + "): Throw in function " +
-                (m_location.function ? m_location.function : "<unknown function>") +
-                "\nDynamic exception type: " + typeid(*this).name() +
-                "\n" + m_description;
-            for (ErrorInfoConcept const* it = m_errorInfos.get(); it != nullptr; it = it->next()) {
-                m_diagnosticMessageCached += std::string("\n[") + it->getTypeInfo().name() + "] = " +
-                                             it->dataString();
-            }
+            m_diagnosticMessageBuilt.callOnce([this]() { buildDiagnosticMessage(); });
             return m_diagnosticMessageCached.c_str();
         }
 
+        void buildDiagnosticMessage() const;
+
         friend char const* getDiagnosticMessage(Exception const& e);
         template<typename ErrorInfo_T, typename Exception_T>
         friend typename ErrorInfo_T::ValueType const* getErrorInfo(Exception_T const& e);
@@ -344,6 +660,8 @@ namespace GHULBUS_BASE_NAMESPACE
             e.setExceptionLocation(error_info.getData());
         } else if constexpr (std::is_same_v<std::decay_t<ErrorInfo_T>, Exception_Info::description>) {
             e.setDescription(std::forward<ErrorInfo_T>(error_info).getData());
+        } else if constexpr (std::is_same_v<std::decay_t<ErrorInfo_T>, Exception_Info::static_description>) {
+            e.setStaticDescription(error_info.getData());
         } else {
             e.addErrorInfo(std::forward<ErrorInfo_T>(error_info));
         }
@@ -357,11 +675,19 @@ namespace GHULBUS_BASE_NAMESPACE
      */
     template<typename ErrorInfo_T, typename Exception_T>
     inline typename ErrorInfo_T::ValueType const* getErrorInfo(Exception_T const& e) {
-        if (Exception const* exc = dynamic_cast<Exception const*>(&e); exc != nullptr) {
+        Exception const* exc;
+        if constexpr (std::is_base_of_v<Exception, Exception_T>) {
+            exc = &e;
+        } else {
+            exc = dynamic_cast<Exception const*>(&e);
+        }
+        if (exc != nullptr) {
             if constexpr (std::is_same_v<std::decay_t<ErrorInfo_T>, Exception_Info::location>) {
                 return &(exc->getLocation());
             } else if constexpr (std::is_same_v<std::decay_t<ErrorInfo_T>, Exception_Info::description>) {
                 return &(exc->getDescription());
+            } else if constexpr (std::is_same_v<std::decay_t<ErrorInfo_T>, Exception_Info::static_description>) {
+                return exc->getStaticDescription();
             } else {
                 return exc->getErrorInfo<ErrorInfo_T>();
             }
@@ -400,6 +726,44 @@ namespace GHULBUS_BASE_NAMESPACE
         return std::move(e);
     }
 
+    namespace impl {
+    /** @cond
+     */
+    /** Decorates an exception thrown by GHULBUS_THROW with a stack trace, if enabled.
+     */
+    template<typename Exception_T>
+    inline Exception_T const& decorateWithStackTrace(Exception_T const& e) {
+        if (isStackTraceCaptureEnabled()) {
+            // no frames are skipped, as this function is usually inlined into the throw site
+            e << Exception_Info::stack_trace(captureStackTrace());
+        }
+        return e;
+    }
+
+    /** Description decorator used by GHULBUS_THROW and GHULBUS_ERROR.
+     * A description is only stored by pointer if it is a string literal or an explicit
+     * Exception_Info::static_description. String literals are told apart from named arrays by the declared type
+     * `Decl_T` of the macro argument, which is only an lvalue reference for the former. Everything else, including
+     * named arrays of char that live on the stack of the throwing function, is copied to a std::string.
+     */
+    template<typename Decl_T, typename T>
+    inline auto makeThrowDescription(T&& str) {
+        using Str = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<Str, Exception_Info::static_description>) {
+            return static_cast<Exception_Info::static_description const&>(str);
+        } else if constexpr (std::is_lvalue_reference_v<Decl_T> && std::is_array_v<Str> &&
+                             std::is_same_v<std::remove_extent_t<std::remove_reference_t<Decl_T>>, char const>) {
+            return Exception_Info::static_description(str);
+        } else if constexpr (std::is_array_v<Str>) {
+            return Exception_Info::description(static_cast<char const*>(str));
+        } else {
+            return Exception_Info::description(std::forward<T>(str));
+        }
+    }
+    /** @endcond
+     */
+    }
+
     /** Concrete exception objects.
      */
     namespace Exceptions
@@ -456,31 +820,44 @@ namespace GHULBUS_BASE_NAMESPACE
     }
 }
 
-/** @cond
- */
-#if defined _MSC_VER
-#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __FUNCSIG__
-#elif defined __clang__
-#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __PRETTY_FUNCTION__
-#elif defined __GNUC__
-#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __PRETTY_FUNCTION__
+#ifdef GHULBUS_CONFIG_EXCEPTION_STACK_TRACES
+#   define GHULBUS_INTERNAL_THROW_DECORATE_STACK_TRACE(exc) ::GHULBUS_BASE_NAMESPACE::impl::decorateWithStackTrace(exc)
 #else
-#   define GHULBUS_INTERNAL_HELPER_FUNCTION_2 __func__
+#   define GHULBUS_INTERNAL_THROW_DECORATE_STACK_TRACE(exc) (exc)
+#endif
+
+#ifdef GHULBUS_CONFIG_EXCEPTION_THROW_TELEMETRY
+#   define GHULBUS_INTERNAL_THROW_COUNT(exc)                                                                    \
+    ::GHULBUS_BASE_NAMESPACE::impl::countThrow((exc),                                                          \
+        [](char const* function) -> ::GHULBUS_BASE_NAMESPACE::ThrowSite& {                                      \
+            static ::GHULBUS_BASE_NAMESPACE::ThrowSite site(__FILE__, function, __LINE__,                       \
+                                                            typeid(::std::remove_cvref_t<decltype(exc)>));      \
+            return site;                                                                                        \
+        }(GHULBUS_INTERNAL_HELPER_FUNCTION_2))
+#else
+#   define GHULBUS_INTERNAL_THROW_COUNT(exc) (exc)
 #endif
-/** @endcond
- */
 
 /** Throw a Ghulbus::Exception.
  * All exceptions thrown with this macro will be decorated with the supplied string description and information
  * about the source code location that triggered the throw.
+ * If the description is a string literal, it is stored by pointer as Exception_Info::static_description, so
+ * that throwing does not allocate.
+ * If `GHULBUS_CONFIG_EXCEPTION_STACK_TRACES` is defined, the exception is also decorated with an
+ * Exception_Info::stack_trace, unless disabled at runtime with setStackTraceCaptureEnabled().
+ * If `GHULBUS_CONFIG_EXCEPTION_THROW_TELEMETRY` is defined, every throw is counted in the ThrowSite of the macro
+ * invocation, see ThrowSiteSnapshot.
  * @param exc An exception object inheriting from Ghulbus::Exception.
  * @param str A std::string or null-terminated C-string to attach to the exception as description.
+ *            Only string literals are stored by pointer; all other strings, including named char arrays, are
+ *            copied. An Exception_Info::static_description may be passed to store any other string with static
+ *            storage duration by pointer.
  */
 #define GHULBUS_THROW(exc, str) \
-    throw ( (exc) <<                                                                            \
+    throw ( GHULBUS_INTERNAL_THROW_COUNT(GHULBUS_INTERNAL_THROW_DECORATE_STACK_TRACE(exc)) <<    \
         ::GHULBUS_BASE_NAMESPACE::Exception_Info::location(__FILE__,                            \
                                                            GHULBUS_INTERNAL_HELPER_FUNCTION_2,  \
                                                            __LINE__) <<                         \
-        ::GHULBUS_BASE_NAMESPACE::Exception_Info::description(str) )
+        ::GHULBUS_BASE_NAMESPACE::impl::makeThrowDescription<decltype(str)>(str) )
 
 #endif
@@ -0,0 +1,97 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_EXCEPTION_TELEMETRY_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_EXCEPTION_TELEMETRY_HPP
+
+/** @file
+ *
+ * @brief Counting of exceptions per throw site.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <typeinfo>
+#include <vector>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+/** A source code location from which exceptions are thrown.
+ * If `GHULBUS_CONFIG_EXCEPTION_THROW_TELEMETRY` is defined, every use of \ref GHULBUS_THROW owns a static ThrowSite
+ * that counts how often an exception was thrown from there. Sites register themselves upon the first throw.
+ */
+class ThrowSite {
+private:
+    char const* m_file;
+    char const* m_function;
+    long m_line;
+    std::type_info const* m_exceptionType;
+    std::atomic<std::uint64_t> m_count;
+    ThrowSite* m_next;
+public:
+    /** Constructs and registers a throw site.
+     * ThrowSite objects must have static storage duration, as they are never unregistered.
+     */
+    GHULBUS_BASE_API ThrowSite(char const* file, char const* function, long line,
+                               std::type_info const& exception_type) noexcept;
+
+    ThrowSite(ThrowSite const&) = delete;
+    ThrowSite& operator=(ThrowSite const&) = delete;
+
+    void count() noexcept
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    friend struct ThrowSiteSnapshot;
+};
+
+/** Throw counts of all registered throw sites at a point in time.
+ */
+struct ThrowSiteSnapshot {
+    struct Site {
+        ThrowSite const* site;                  ///< Identifies the site across snapshots.
+        char const* file;
+        char const* function;
+        long line;
+        std::type_info const* exception_type;   ///< Static type of the exception expression at the throw site.
+        std::uint64_t count;                    ///< Total number of throws.
+        std::uint64_t delta;                    ///< Number of throws since the previous snapshot.
+    };
+
+    std::chrono::steady_clock::time_point timestamp;
+    std::chrono::steady_clock::duration interval;   ///< Time since the previous snapshot.
+    std::vector<Site> sites;                        ///< Sorted by descending delta.
+
+    /** Takes a snapshot of all throw sites that were hit at least once.
+     * @param[in] previous If not null, deltas and the interval are computed relative to this snapshot.
+     *                     Otherwise they are relative to program start.
+     */
+    GHULBUS_BASE_API static ThrowSiteSnapshot take(ThrowSiteSnapshot const* previous = nullptr);
+
+    /** Throws per second of a site within the interval of the snapshot.
+     */
+    double rate(Site const& s) const noexcept
+    {
+        double const seconds = std::chrono::duration<double>(interval).count();
+        return (seconds > 0.0) ? (static_cast<double>(s.delta) / seconds) : 0.0;
+    }
+};
+
+namespace impl {
+/** @cond
+ */
+/** Counts a throw from a site. Used by GHULBUS_THROW.
+ */
+template<typename Exception_T>
+inline Exception_T const& countThrow(Exception_T const& e, ThrowSite& site) noexcept {
+    site.count();
+    return e;
+}
+/** @endcond
+ */
+}
+}
+
+#endif
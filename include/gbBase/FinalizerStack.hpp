@@ -0,0 +1,173 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_FINALIZER_STACK_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_FINALIZER_STACK_HPP
+
+/** @file
+ *
+ * @brief Stack of cleanup actions.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/Finally.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+
+/** A stack of cleanup actions that are executed in reverse order of their insertion.
+ * This is a replacement for a `std::vector<AnyFinalizer>` for code that performs a number of steps that each have
+ * to be undone later, like a transaction. The callables are stored back to back in chunks of memory that are
+ * owned by the stack, so pushing a callable does not allocate unless the current chunk is exhausted.
+ * Chunks are kept for reuse after the stack was unwound or defused.
+ *
+ * With UnwindPolicy::Always, the actions are executed on destruction. With UnwindPolicy::OnException, the actions
+ * are only executed if the stack is destroyed during stack unwinding due to an exception, which allows to roll back
+ * a partially completed operation. In both cases, defuse() discards all actions without executing them.
+ *
+ * @b Example
+   @code
+   FinalizerStack rollback(FinalizerStack::UnwindPolicy::OnException);
+   for (auto& r : resources) {
+       acquire(r);
+       rollback.push([&r]() { release(r); });
+   }
+   // if any of the acquire() calls throws, all previously acquired resources are released
+   @endcode
+ */
+class FinalizerStack {
+public:
+    enum class UnwindPolicy {
+        Always,             ///< Execute the actions on destruction.
+        OnException         ///< Execute the actions only if destroyed due to an exception.
+    };
+
+    static constexpr std::size_t default_chunk_size = 1024;
+private:
+    struct Entry {
+        Entry* previous;
+        void (*finalize)(Entry* e, bool invoke) noexcept;
+    };
+
+    template<typename T>
+    struct IsFinalizer : std::false_type {};
+
+    template<typename F>
+    struct IsFinalizer<Finalizer<F>> : std::true_type {};
+
+    struct Chunk {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    template<typename F>
+    struct Model {
+        static constexpr std::size_t offset = (sizeof(Entry) + alignof(F) - 1) / alignof(F) * alignof(F);
+
+        static F& get(Entry* e) noexcept {
+            return *std::launder(reinterpret_cast<F*>(reinterpret_cast<std::byte*>(e) + offset));
+        }
+
+        static void finalize(Entry* e, bool invoke) noexcept {
+            F& f = get(e);
+            if constexpr (IsFinalizer<F>::value) {
+                if (!invoke) { f.defuse(); }
+            } else {
+                if (invoke) { f(); }
+            }
+            f.~F();
+        }
+    };
+
+    Entry* m_top = nullptr;
+    std::size_t m_size = 0;
+    std::vector<Chunk> m_chunks;
+    std::size_t m_currentChunk = 0;
+    std::size_t m_chunkOffset = 0;
+    std::size_t m_chunkSize;
+    UnwindPolicy m_policy;
+    int m_uncaughtExceptions;
+public:
+    /** Constructs an empty stack.
+     * @param[in] policy Determines whether actions are executed on destruction.
+     * @param[in] chunk_size Size in bytes of the first memory chunk. No memory is allocated before the first push.
+     */
+    GHULBUS_BASE_API explicit FinalizerStack(UnwindPolicy policy = UnwindPolicy::Always,
+                                             std::size_t chunk_size = default_chunk_size);
+
+    /** Destructor.
+     * Executes all actions in reverse order, unless the UnwindPolicy prevents it.
+     */
+    GHULBUS_BASE_API ~FinalizerStack();
+
+    FinalizerStack(FinalizerStack const&) = delete;
+    FinalizerStack& operator=(FinalizerStack const&) = delete;
+
+    /** Adds an action to the top of the stack.
+     * If the action cannot be stored because copying or moving it or allocating memory throws, it is invoked
+     * immediately before the exception propagates.
+     * @param[in] f A Callable object that is invocable without arguments, or a Finalizer.
+     */
+    template<typename Func>
+    void push(Func&& f)
+    {
+        using F = std::decay_t<Func>;
+        if constexpr (IsFinalizer<F>::value) {
+            // if storing throws, the argument still runs its action upon destruction
+            emplace<F>(std::forward<Func>(f));
+        } else {
+            static_assert(std::is_invocable_v<F&>, "Finalizer must be invocable without arguments.");
+            try {
+                emplace<F>(std::forward<Func>(f));
+            } catch (...) {
+                f();
+                throw;
+            }
+        }
+    }
+
+    /** Executes all actions in reverse order of their insertion and removes them from the stack.
+     */
+    GHULBUS_BASE_API void unwind() noexcept;
+
+    /** Removes all actions from the stack without executing them.
+     */
+    GHULBUS_BASE_API void defuse() noexcept;
+
+    /** Number of actions on the stack.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+private:
+    template<typename F, typename Func>
+    void emplace(Func&& f)
+    {
+        void* p = allocate(Model<F>::offset + sizeof(F), std::max(alignof(Entry), alignof(F)));
+        ::new(static_cast<std::byte*>(p) + Model<F>::offset) F(std::forward<Func>(f));
+        Entry* e = ::new(p) Entry;
+        e->previous = m_top;
+        e->finalize = &Model<F>::finalize;
+        m_top = e;
+        ++m_size;
+    }
+
+    GHULBUS_BASE_API void* allocate(std::size_t size, std::size_t alignment);
+    void popAll(bool invoke) noexcept;
+};
+
+}
+
+#endif
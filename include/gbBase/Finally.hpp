@@ -9,7 +9,8 @@
 
 #include <gbBase/config.hpp>
 
-#include <memory>
+#include <cstddef>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -50,6 +51,8 @@ private:
 };
 
 /** Type-erased wrapper for Finalizer types.
+ * Finalizers of up to 4 pointers in size, like lambdas capturing a few references, are stored inline.
+ * Only bigger finalizers are allocated on the heap.
  */
 class AnyFinalizer {
 public:
@@ -61,13 +64,34 @@ public:
      */
     template<class F>
     AnyFinalizer(Finalizer<F>&& f)
-        :m_finalizer(std::make_unique<Model<F>>(std::move(f)))
-    {}
+    {
+        if constexpr (storesInline<F>()) {
+            ::new(&m_storage.buffer) Finalizer<F>(std::move(f));
+            m_vtable = &InlineModel<F>::vtable;
+        } else {
+            m_storage.heap = new Finalizer<F>(std::move(f));
+            m_vtable = &HeapModel<F>::vtable;
+        }
+    }
 
-    ~AnyFinalizer() noexcept = default;
+    ~AnyFinalizer() noexcept
+    {
+        reset();
+    }
 
-    AnyFinalizer(AnyFinalizer&& rhs) = default;
-    AnyFinalizer& operator=(AnyFinalizer&& rhs) = default;
+    AnyFinalizer(AnyFinalizer&& rhs) noexcept
+    {
+        takeFrom(rhs);
+    }
+
+    AnyFinalizer& operator=(AnyFinalizer&& rhs) noexcept
+    {
+        if (&rhs != this) {
+            reset();
+            takeFrom(rhs);
+        }
+        return *this;
+    }
 
     AnyFinalizer(AnyFinalizer const&) = delete;
     AnyFinalizer& operator=(AnyFinalizer const&) = delete;
@@ -75,7 +99,7 @@ public:
     /** Checks if the wrapper is currently empty.
      */
     operator bool() const noexcept {
-        return m_finalizer.operator bool();
+        return m_vtable != nullptr;
     }
 
     /** Invokes defuse on the contained Finalizer.
@@ -83,30 +107,89 @@ public:
      */
     void defuse() noexcept
     {
-        m_finalizer->defuse();
+        m_vtable->defuse(m_storage);
+    }
+
+    /** Checks whether a Finalizer<F> is stored inline, without allocating.
+     */
+    template<class F>
+    static constexpr bool storesInline() noexcept
+    {
+        return (sizeof(Finalizer<F>) <= sizeof(Storage::buffer)) && (alignof(Finalizer<F>) <= alignof(Storage));
     }
 private:
-    struct Concept {
-        virtual ~Concept() = default;
-        virtual void defuse() noexcept = 0;
+    union Storage {
+        void* heap;
+        alignas(void*) std::byte buffer[4 * sizeof(void*)];
+    };
+
+    struct VTable {
+        void (*relocate)(Storage& dst, Storage& src) noexcept;
+        void (*destroy)(Storage& s) noexcept;
+        void (*defuse)(Storage& s) noexcept;
     };
 
     template<class F>
-    struct Model : Concept {
-        Finalizer<F> finalizer_;
+    struct InlineModel {
+        static Finalizer<F>& get(Storage& s) noexcept {
+            return *std::launder(reinterpret_cast<Finalizer<F>*>(&s.buffer));
+        }
 
-        Model(Finalizer<F>&& f)
-            :finalizer_(std::move(f))
-        {}
+        static void relocate(Storage& dst, Storage& src) noexcept {
+            ::new(&dst.buffer) Finalizer<F>(std::move(get(src)));
+            get(src).~Finalizer<F>();
+        }
 
-        ~Model() override = default;
+        static void destroy(Storage& s) noexcept {
+            get(s).~Finalizer<F>();
+        }
 
-        void defuse() noexcept override {
-            finalizer_.defuse();
+        static void defuse(Storage& s) noexcept {
+            get(s).defuse();
         }
+
+        static constexpr VTable vtable{ &relocate, &destroy, &defuse };
+    };
+
+    template<class F>
+    struct HeapModel {
+        static Finalizer<F>& get(Storage& s) noexcept {
+            return *static_cast<Finalizer<F>*>(s.heap);
+        }
+
+        static void relocate(Storage& dst, Storage& src) noexcept {
+            dst.heap = src.heap;
+        }
+
+        static void destroy(Storage& s) noexcept {
+            delete &get(s);
+        }
+
+        static void defuse(Storage& s) noexcept {
+            get(s).defuse();
+        }
+
+        static constexpr VTable vtable{ &relocate, &destroy, &defuse };
     };
 
-    std::unique_ptr<Concept> m_finalizer;
+    void reset() noexcept
+    {
+        if (m_vtable) {
+            m_vtable->destroy(m_storage);
+            m_vtable = nullptr;
+        }
+    }
+
+    void takeFrom(AnyFinalizer& rhs) noexcept
+    {
+        if (rhs.m_vtable) {
+            rhs.m_vtable->relocate(m_storage, rhs.m_storage);
+            m_vtable = std::exchange(rhs.m_vtable, nullptr);
+        }
+    }
+
+    VTable const* m_vtable = nullptr;
+    Storage m_storage;
 };
 
 /** Constructs a Finalizer to invoke code at the end of scope.
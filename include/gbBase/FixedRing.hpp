@@ -10,7 +10,9 @@
 #include <gbBase/config.hpp>
 #include <gbBase/Assert.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace GHULBUS_BASE_NAMESPACE
@@ -61,14 +63,13 @@ public:
     void push_back(TT&& v)
     {
         GHULBUS_PRECONDITION(!full());
-        if (m_ring.size() < m_ring.capacity()) {
+        if (m_push_idx == m_ring.capacity()) { m_push_idx = 0; }
+        if (m_push_idx == m_ring.size()) {
             m_ring.push_back(std::forward<TT>(v));
-            ++m_push_idx;
-            ++m_n_elements;
-            return;
+        } else {
+            m_ring[m_push_idx] = std::forward<TT>(v);
         }
-        if (m_push_idx == m_ring.capacity()) { m_push_idx = 0; }
-        m_ring[m_push_idx++] = std::forward<TT>(v);
+        ++m_push_idx;
         ++m_n_elements;
     }
 
@@ -83,6 +84,20 @@ public:
         return std::move(m_ring[front_idx]);
     }
 
+    /** Retrieve an element from the back of the ring buffer.
+     * \pre !empty()
+     */
+    value_type pop_back()
+    {
+        GHULBUS_PRECONDITION(!empty());
+        --m_push_idx;
+        --m_n_elements;
+        size_type const back_idx = m_push_idx;
+        // the push index always points one past the last element; for a wrapped ring that is the end of the storage
+        if ((m_push_idx == 0) && (m_n_elements > 0)) { m_push_idx = m_ring.capacity(); }
+        return std::move(m_ring[back_idx]);
+    }
+
     /** Maximum number of elements that the ring buffer can hold at once.
      */
     size_type capacity() const noexcept
@@ -146,6 +161,46 @@ public:
         return m_ring[m_push_idx - 1];
     }
 
+    /** The first contiguous segment of stored elements.
+     * The elements of the ring buffer are stored in at most two contiguous chunks of memory.
+     * array_one() starts with the front() element, array_two() ends with the back() element.
+     * Traversing array_one() followed by array_two() yields all elements in order.
+     */
+    std::span<value_type> array_one() noexcept
+    {
+        size_type const front_idx = front_index();
+        return std::span<value_type>(m_ring.data() + front_idx, std::min(m_n_elements, m_ring.capacity() - front_idx));
+    }
+
+    /** @copydoc array_one()
+     */
+    std::span<value_type const> array_one() const noexcept
+    {
+        size_type const front_idx = front_index();
+        return std::span<value_type const>(m_ring.data() + front_idx,
+                                           std::min(m_n_elements, m_ring.capacity() - front_idx));
+    }
+
+    /** The second contiguous segment of stored elements.
+     * This is empty unless the stored elements wrap around the end of the underlying storage.
+     * @see array_one()
+     */
+    std::span<value_type> array_two() noexcept
+    {
+        size_type const front_idx = front_index();
+        size_type const n_one = std::min(m_n_elements, m_ring.capacity() - front_idx);
+        return std::span<value_type>(m_ring.data(), m_n_elements - n_one);
+    }
+
+    /** @copydoc array_two()
+     */
+    std::span<value_type const> array_two() const noexcept
+    {
+        size_type const front_idx = front_index();
+        size_type const n_one = std::min(m_n_elements, m_ring.capacity() - front_idx);
+        return std::span<value_type const>(m_ring.data(), m_n_elements - n_one);
+    }
+
     inline friend bool operator==(FixedRing const& lhs, FixedRing const& rhs) noexcept
     {
         size_type const l_n = lhs.available();
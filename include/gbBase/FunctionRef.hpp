@@ -0,0 +1,110 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_FUNCTION_REF_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_FUNCTION_REF_HPP
+
+/** @file
+ *
+ * @brief A non-owning reference to a callable object.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/Assert.hpp>
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+
+template<typename Signature>
+class FunctionRef;
+
+/** A non-owning reference to a callable object.
+ * This is intended for callback parameters of functions that only invoke the callback during the call, like
+ * visitors. A FunctionRef is the size of two pointers, never allocates and is trivially copyable.
+ * Invoking it amounts to a single indirect call.
+ *
+ * A FunctionRef binds to any callable, including temporaries. It does not extend the lifetime of the referenced
+ * callable, so it must not outlive the callable it was constructed from. The referenced callable is always
+ * invoked as an lvalue. Functions and function pointers are bound by value.
+ *
+ * @b Example
+   @code
+   void forEachElement(FunctionRef<void(Element const&)> visitor);
+   forEachElement([&count](Element const&) { ++count; });
+   @endcode
+ */
+template<typename T_Return, typename... T_Args, bool IsNoexcept>
+class FunctionRef<T_Return(T_Args...) noexcept(IsNoexcept)> {
+private:
+    union Bound {
+        void* object;
+        void (*function)();
+    };
+
+    using Invoker = T_Return(*)(Bound, T_Args&&...) noexcept(IsNoexcept);
+
+    Bound m_bound;
+    Invoker m_invoke;
+
+    template<typename F>
+    static constexpr bool isInvocable() noexcept
+    {
+        if constexpr (IsNoexcept) {
+            return std::is_nothrow_invocable_r_v<T_Return, F, T_Args...>;
+        } else {
+            return std::is_invocable_r_v<T_Return, F, T_Args...>;
+        }
+    }
+
+    template<typename T_Invocable, typename... T_InvokeArgs>
+    static T_Return doInvoke(T_Invocable&& f, T_InvokeArgs&&... args) noexcept(IsNoexcept)
+    {
+        if constexpr (std::is_void_v<T_Return>) {
+            std::invoke(std::forward<T_Invocable>(f), std::forward<T_InvokeArgs>(args)...);
+        } else {
+            return std::invoke(std::forward<T_Invocable>(f), std::forward<T_InvokeArgs>(args)...);
+        }
+    }
+public:
+    /** Constructs a reference to a function.
+     * \pre f is not null.
+     */
+    template<typename F, typename = std::enable_if_t<std::is_function_v<F> && isInvocable<F*>()>>
+    FunctionRef(F* f) noexcept
+    {
+        GHULBUS_PRECONDITION_DBG(f);
+        m_bound.function = reinterpret_cast<void (*)()>(f);
+        m_invoke = [](Bound b, T_Args&&... args) noexcept(IsNoexcept) -> T_Return {
+            return doInvoke(reinterpret_cast<F*>(b.function), std::forward<T_Args>(args)...);
+        };
+    }
+
+    /** Constructs a reference to a callable object.
+     */
+    template<typename F, typename T = std::remove_reference_t<F>,
+             typename = std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, FunctionRef> &&
+                                         !std::is_function_v<T> && !std::is_pointer_v<std::remove_cv_t<T>> &&
+                                         isInvocable<T&>()>>
+    FunctionRef(F&& f) noexcept
+    {
+        m_bound.object = const_cast<void*>(static_cast<void const volatile*>(std::addressof(f)));
+        m_invoke = [](Bound b, T_Args&&... args) noexcept(IsNoexcept) -> T_Return {
+            return doInvoke(*static_cast<T*>(b.object), std::forward<T_Args>(args)...);
+        };
+    }
+
+    FunctionRef(FunctionRef const&) noexcept = default;
+    FunctionRef& operator=(FunctionRef const&) noexcept = default;
+
+    T_Return operator()(T_Args... args) const noexcept(IsNoexcept)
+    {
+        return m_invoke(m_bound, std::forward<T_Args>(args)...);
+    }
+};
+
+}
+
+#endif
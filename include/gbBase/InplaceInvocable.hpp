@@ -0,0 +1,117 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_INPLACE_INVOCABLE_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_INPLACE_INVOCABLE_HPP
+
+/** @file
+ *
+ * @brief A type erased wrapper for callable objects with fixed-size inline storage.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/AnyInvocable.hpp>
+#include <gbBase/Assert.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+
+template<typename Signature, std::size_t Capacity = 4 * sizeof(void*),
+         std::size_t Alignment = alignof(std::max_align_t)>
+class InplaceInvocable;
+
+/** An owning, move-only type erased wrapper for callable objects that never allocates.
+ * The callable is always stored in a buffer of `Capacity` bytes inside the InplaceInvocable object.
+ * Constructing an InplaceInvocable from a callable that is too big, requires a stricter alignment than
+ * `Alignment` or is not nothrow move constructible fails to compile.
+ *
+ * This allows fully preallocated task queues for real-time threads, e.g. by storing InplaceInvocables in a
+ * FixedRing. Moves are always noexcept and, for trivially copyable callables, amount to copying the buffer.
+ * As with AnyInvocable, invoking the callable is a single indirect call. The call operator invokes the stored
+ * callable as a non-const lvalue. The signature may be `noexcept`.
+ */
+template<typename T_Return, typename... T_Args, bool IsNoexcept, std::size_t Capacity, std::size_t Alignment>
+class InplaceInvocable<T_Return(T_Args...) noexcept(IsNoexcept), Capacity, Alignment>
+    : public impl::AnyInvocableBase<Capacity, Alignment, IsNoexcept, T_Return, T_Args...>
+{
+private:
+    using Base = impl::AnyInvocableBase<Capacity, Alignment, IsNoexcept, T_Return, T_Args...>;
+
+    template<typename F>
+    static constexpr bool isInvocable() noexcept
+    {
+        if constexpr (IsNoexcept) {
+            return std::is_nothrow_invocable_r_v<T_Return, F&, T_Args...>;
+        } else {
+            return std::is_invocable_r_v<T_Return, F&, T_Args...>;
+        }
+    }
+public:
+    /** Checks whether a callable of type `F` can be stored.
+     */
+    template<typename F>
+    static constexpr bool fits() noexcept
+    {
+        return Base::template storesInline<F>();
+    }
+
+    InplaceInvocable() noexcept = default;
+
+    InplaceInvocable(std::nullptr_t) noexcept
+    {}
+
+    template<typename Func, typename F = std::decay_t<Func>,
+             typename = std::enable_if_t<!std::is_same_v<F, InplaceInvocable> && isInvocable<F>()>>
+    InplaceInvocable(Func&& f) noexcept(std::is_nothrow_constructible_v<F, Func&&>)
+    {
+        if (!Base::template isNullCallable<F>(f)) {
+            emplace<F>(std::forward<Func>(f));
+        }
+    }
+
+    /** Constructs a callable of type `F` in place from the given constructor arguments.
+     */
+    template<typename F, typename... T_CtorArgs>
+    explicit InplaceInvocable(std::in_place_type_t<F>, T_CtorArgs&&... ctor_args)
+        noexcept(std::is_nothrow_constructible_v<F, T_CtorArgs&&...>)
+    {
+        static_assert(std::is_same_v<F, std::decay_t<F>>, "In-place type must be an object type.");
+        static_assert(isInvocable<F>(), "In-place type is not callable with the given signature.");
+        emplace<F>(std::forward<T_CtorArgs>(ctor_args)...);
+    }
+
+    InplaceInvocable(InplaceInvocable&&) noexcept = default;
+    InplaceInvocable& operator=(InplaceInvocable&&) noexcept = default;
+
+    InplaceInvocable& operator=(std::nullptr_t) noexcept
+    {
+        this->reset();
+        return *this;
+    }
+
+    /** Invokes the stored callable.
+     * \pre The object is not empty.
+     */
+    T_Return operator()(T_Args... args) noexcept(IsNoexcept)
+    {
+        GHULBUS_PRECONDITION(this->m_invoke);
+        return this->m_invoke(this->m_storage, std::forward<T_Args>(args)...);
+    }
+private:
+    /** Unlike AnyInvocable, there is no fallback to the heap for callables that do not fit.
+     */
+    template<typename F, typename... T_CtorArgs>
+    void emplace(T_CtorArgs&&... ctor_args)
+    {
+        static_assert(sizeof(F) <= Capacity, "Callable does not fit into the storage of the InplaceInvocable.");
+        static_assert(alignof(F) <= Alignment, "Callable exceeds the alignment of the InplaceInvocable.");
+        static_assert(std::is_nothrow_move_constructible_v<F>, "Callable must be nothrow move constructible.");
+        Base::template emplace<F, F&>(std::forward<T_CtorArgs>(ctor_args)...);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_MULTICAST_RING_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_MULTICAST_RING_HPP
+
+/** @file
+ *
+ * @brief Single-writer ring buffer with multiple independent consumers.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/Assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+/** A ring buffer where every element is seen by every consumer.
+ * A single writer thread publishes elements to the ring. Each consumer owns a cursor that tracks how far it has
+ * processed the published elements, so all consumers read every element independently and without copying.
+ * The writer will not overwrite a slot before every consumer has released it.
+ *
+ * Consumers may depend on other consumers. A consumer will only see elements that all of its dependencies have
+ * already released, which allows building processing pipelines on top of a single ring.
+ *
+ * Slots are allocated and default constructed once on construction. The writer obtains a reference to the next
+ * slot with claim() and overwrites it in place, so that types like `std::string` can reuse their storage.
+ *
+ * Elements are identified by their sequence number. The first element published to the ring has sequence 0.
+ * Threads only block if they cannot make progress. Blocked threads are parked using `std::atomic::wait` and will
+ * only be notified if somebody is actually waiting.
+ *
+ * @b Example
+   @code
+   MulticastRing<std::string> ring(1024);
+   auto& file_sink = ring.addConsumer();
+   auto& net_sink = ring.addConsumer();
+   // writer thread:
+   ring.claim() = "Lorem ipsum";
+   ring.publish();
+   // consumer threads:
+   for (MulticastRing<std::string>::Sequence seq = file_sink.cursor();; ++seq) {
+       if (file_sink.waitFor(seq) <= seq) { break; }     // ring was closed
+       write_to_file(file_sink.get(seq));
+       file_sink.release(seq + 1);
+   }
+   @endcode
+ */
+template<typename T>
+class MulticastRing {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using Sequence = std::uint64_t;
+private:
+    static constexpr std::size_t cache_line_size = 64;
+public:
+    /** A consumer of the ring.
+     * Consumers are obtained from MulticastRing::addConsumer() and remain owned by the ring.
+     * All member functions of a consumer must be called from the same thread.
+     */
+    class Consumer {
+        friend class MulticastRing;
+    private:
+        MulticastRing* m_ring;
+        std::vector<Consumer const*> m_dependencies;
+        alignas(cache_line_size) std::atomic<Sequence> m_cursor;   ///< number of elements released
+    public:
+        Consumer(MulticastRing& ring, std::vector<Consumer const*> dependencies, Sequence start)
+            :m_ring(&ring), m_dependencies(std::move(dependencies)), m_cursor(start)
+        {}
+
+        Consumer(Consumer const&) = delete;
+        Consumer& operator=(Consumer const&) = delete;
+
+        /** Sequence of the first element that has not been released by this consumer.
+         */
+        Sequence cursor() const noexcept
+        {
+            return m_cursor.load(std::memory_order_relaxed);
+        }
+
+        /** Number of elements that may be accessed by this consumer.
+         * All elements from cursor() up to, but not including, the returned sequence can be accessed with get().
+         * This takes into account both the elements published by the writer and those released by dependencies.
+         */
+        Sequence available() const noexcept
+        {
+            Sequence ret = m_ring->m_published.load(std::memory_order_acquire);
+            for (Consumer const* dep : m_dependencies) {
+                ret = std::min(ret, dep->m_cursor.load(std::memory_order_acquire));
+            }
+            return ret;
+        }
+
+        /** Blocks until the element with the given sequence becomes available.
+         * @return The value of available(). This is greater than `seq` unless the ring was closed and all
+         *         published elements have been released by the dependencies of this consumer.
+         *         All elements up to the returned sequence can be processed as a batch.
+         */
+        Sequence waitFor(Sequence seq)
+        {
+            // once the ring is closed, published() is final; dependencies may still be catching up with it
+            return m_ring->waitUntil([this, seq]() {
+                    return (available() > seq) || (m_ring->closed() && (available() == m_ring->published()));
+                }, [this]() { return available(); });
+        }
+
+        /** Access the element with the given sequence.
+         * \pre cursor() <= seq < available()
+         */
+        T& get(Sequence seq) noexcept
+        {
+            GHULBUS_PRECONDITION_DBG((seq >= cursor()) && (seq < available()));
+            return m_ring->m_slots[seq % m_ring->m_slots.size()];
+        }
+
+        /** Releases all elements before the given sequence.
+         * Released elements must no longer be accessed by this consumer. They become available to consumers that
+         * depend on this consumer and, once released by all consumers, the writer may overwrite them.
+         * \pre cursor() <= seq <= available()
+         */
+        void release(Sequence seq)
+        {
+            GHULBUS_PRECONDITION_DBG((seq >= cursor()) && (seq <= available()));
+            m_cursor.store(seq, std::memory_order_release);
+            m_ring->signalProgress();
+        }
+    };
+private:
+    std::vector<T> m_slots;
+    std::vector<std::unique_ptr<Consumer>> m_consumers;
+    Sequence m_claimed;                             ///< writer-local: number of elements claimed
+    Sequence m_cachedGate;                          ///< writer-local: last known minimum of all consumer cursors
+    bool m_hasClaim;
+    alignas(cache_line_size) std::atomic<Sequence> m_published;     ///< number of elements published
+    alignas(cache_line_size) std::atomic<std::uint32_t> m_progressSignal;
+    std::atomic<std::uint32_t> m_waiting;
+    std::atomic<bool> m_isClosed;
+public:
+    /** Constructor.
+     * @param[in] capacity Number of slots in the ring.
+     * \pre capacity > 0
+     */
+    explicit MulticastRing(size_type capacity)
+        :m_slots(capacity), m_claimed(0), m_cachedGate(0), m_hasClaim(false),
+         m_published(0), m_progressSignal(0), m_waiting(0), m_isClosed(false)
+    {
+        GHULBUS_PRECONDITION(capacity > 0);
+    }
+
+    MulticastRing(MulticastRing const&) = delete;
+    MulticastRing& operator=(MulticastRing const&) = delete;
+
+    /** Adds a new consumer to the ring.
+     * The consumer will see all elements published after this call.
+     * @param[in] dependencies Consumers that have to release an element before the new consumer may access it.
+     *                         All dependencies must be consumers of the same ring.
+     * @return A reference to the new consumer. The consumer is owned by the ring.
+     * @attention This function must not be called concurrently with any other function of the ring.
+     */
+    Consumer& addConsumer(std::initializer_list<Consumer const*> dependencies = {})
+    {
+        for ([[maybe_unused]] Consumer const* dep : dependencies) {
+            GHULBUS_PRECONDITION(dep && (dep->m_ring == this));
+        }
+        Sequence const start = m_published.load(std::memory_order_relaxed);
+        m_consumers.push_back(std::make_unique<Consumer>(*this, std::vector<Consumer const*>(dependencies), start));
+        return *m_consumers.back();
+    }
+
+    /** Obtain the slot for the next element.
+     * Blocks until all consumers have released the element previously stored in that slot.
+     * The returned slot still contains the old element and is to be overwritten in place.
+     * The element becomes visible to consumers with publish().
+     * @attention Only a single thread may act as writer.
+     * \pre There is no outstanding claim that has not been published.
+     */
+    T& claim()
+    {
+        GHULBUS_PRECONDITION_DBG(!m_hasClaim);
+        if (m_claimed - m_cachedGate >= m_slots.size()) {
+            m_cachedGate = waitUntil([this]() { return m_claimed - minimumCursor() < m_slots.size(); },
+                                     [this]() { return minimumCursor(); });
+        }
+        m_hasClaim = true;
+        return m_slots[m_claimed % m_slots.size()];
+    }
+
+    /** Publish the element obtained from the last call to claim().
+     * \pre claim() was called.
+     */
+    void publish()
+    {
+        GHULBUS_PRECONDITION_DBG(m_hasClaim);
+        m_hasClaim = false;
+        ++m_claimed;
+        m_published.store(m_claimed, std::memory_order_release);
+        signalProgress();
+    }
+
+    /** Convenience function for claiming a slot, assigning to it and publishing it.
+     */
+    template<typename TT>
+    void push(TT&& v)
+    {
+        claim() = std::forward<TT>(v);
+        publish();
+    }
+
+    /** Number of elements published by the writer.
+     * This is also the sequence of the next element to be published.
+     */
+    Sequence published() const noexcept
+    {
+        return m_published.load(std::memory_order_acquire);
+    }
+
+    /** Closes the ring.
+     * This is to be called by the writer once it has published its last element.
+     * Wakes up all consumers blocked in Consumer::waitFor(). Calls to that function will no longer block once
+     * all published elements have been processed. Note that claim() is not affected by closing the ring.
+     */
+    void close()
+    {
+        m_isClosed.store(true, std::memory_order_seq_cst);
+        m_progressSignal.fetch_add(1, std::memory_order_release);
+        m_progressSignal.notify_all();
+    }
+
+    /** Checks whether close() has been called.
+     */
+    bool closed() const noexcept
+    {
+        return m_isClosed.load(std::memory_order_acquire);
+    }
+
+    /** Number of slots in the ring.
+     */
+    size_type capacity() const noexcept
+    {
+        return m_slots.size();
+    }
+private:
+    Sequence minimumCursor() const noexcept
+    {
+        Sequence ret = m_claimed;
+        for (auto const& c : m_consumers) {
+            ret = std::min(ret, c->m_cursor.load(std::memory_order_acquire));
+        }
+        return ret;
+    }
+
+    /** Blocks until condition() returns true; returns result().
+     * The fence pairs with the one in signalProgress(): Either we see the progress made by the signaling thread,
+     * or the signaling thread sees our increment of m_waiting and notifies.
+     */
+    template<typename Condition, typename Result>
+    auto waitUntil(Condition const& condition, Result const& result)
+    {
+        while (!condition()) {
+            m_waiting.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::uint32_t const signal = m_progressSignal.load(std::memory_order_acquire);
+            if (!condition()) {
+                m_progressSignal.wait(signal, std::memory_order_acquire);
+            }
+            m_waiting.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return result();
+    }
+
+    void signalProgress()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting.load(std::memory_order_relaxed) > 0) {
+            m_progressSignal.fetch_add(1, std::memory_order_release);
+            m_progressSignal.notify_all();
+        }
+    }
+};
+
+}
+
+#endif
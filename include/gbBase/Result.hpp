@@ -0,0 +1,213 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_RESULT_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_RESULT_HPP
+
+/** @file
+ *
+ * @brief Error handling without exceptions.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/Exception.hpp>
+
+#include <expected>
+#include <type_traits>
+#include <utility>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+/** Error type for Result.
+ * An Error holds an exception object that has not been thrown. It carries the same decorators and diagnostic
+ * information as the exception would, but only pays for the construction of the exception. Use raise() to throw
+ * the exception with its original dynamic type.
+ * Errors are usually created with \ref GHULBUS_ERROR.
+ */
+class Error {
+private:
+    /** The exception object is owned through its concrete type, as Exception is a virtual base class.
+     */
+    struct VTable {
+        [[noreturn]] void (*raise)(void* object);
+        void* (*clone)(void const* object);
+        void (*destroy)(void* object) noexcept;
+        Exception* (*upcast)(void* object) noexcept;
+    };
+
+    template<typename Exception_T>
+    struct Model {
+        [[noreturn]] static void raise(void* object) {
+            throw std::move(*static_cast<Exception_T*>(object));
+        }
+
+        static void* clone(void const* object) {
+            return new Exception_T(*static_cast<Exception_T const*>(object));
+        }
+
+        static void destroy(void* object) noexcept {
+            delete static_cast<Exception_T*>(object);
+        }
+
+        static Exception* upcast(void* object) noexcept {
+            return static_cast<Exception_T*>(object);
+        }
+
+        static constexpr VTable vtable{ &raise, &clone, &destroy, &upcast };
+    };
+
+    void* m_object;
+    VTable const* m_vtable;
+public:
+    /** Constructs an error from an exception object.
+     * The dynamic type of the exception object must be `Exception_T`.
+     */
+    template<typename Exception_T, typename E = std::remove_cvref_t<Exception_T>,
+             typename = std::enable_if_t<std::is_base_of_v<Exception, E>>>
+    explicit Error(Exception_T&& e)
+        :m_object(new E(std::forward<Exception_T>(e))), m_vtable(&Model<E>::vtable)
+    {}
+
+    ~Error()
+    {
+        if (m_object) { m_vtable->destroy(m_object); }
+    }
+
+    Error(Error const& rhs)
+        :m_object(rhs.m_object ? rhs.m_vtable->clone(rhs.m_object) : nullptr), m_vtable(rhs.m_vtable)
+    {}
+
+    Error& operator=(Error const& rhs)
+    {
+        if (&rhs != this) {
+            Error tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    Error(Error&& rhs) noexcept
+        :m_object(std::exchange(rhs.m_object, nullptr)), m_vtable(rhs.m_vtable)
+    {}
+
+    Error& operator=(Error&& rhs) noexcept
+    {
+        Error tmp(std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(Error& rhs) noexcept
+    {
+        std::swap(m_object, rhs.m_object);
+        std::swap(m_vtable, rhs.m_vtable);
+    }
+
+    /** The exception object held by the error.
+     * \pre The error was not moved from.
+     */
+    Exception const& exception() const noexcept
+    {
+        return *m_vtable->upcast(m_object);
+    }
+
+    /** Throws the exception object held by the error.
+     * \pre The error was not moved from.
+     */
+    [[noreturn]] void raise() &&
+    {
+        m_vtable->raise(m_object);
+    }
+
+    /** Decorate the error with an ErrorInfo.
+     */
+    template<typename ErrorInfo_T, typename = std::enable_if_t<IsErrorInfo<std::decay_t<ErrorInfo_T>>::value>>
+    friend Error& operator<<(Error& e, ErrorInfo_T&& error_info)
+    {
+        e.exception() << std::forward<ErrorInfo_T>(error_info);
+        return e;
+    }
+
+    template<typename ErrorInfo_T, typename = std::enable_if_t<IsErrorInfo<std::decay_t<ErrorInfo_T>>::value>>
+    friend Error&& operator<<(Error&& e, ErrorInfo_T&& error_info)
+    {
+        e.exception() << std::forward<ErrorInfo_T>(error_info);
+        return std::move(e);
+    }
+};
+
+/** Attempts to retrieve the error decoration of type `ErrorInfo_T` from the error `e`.
+ * @return A pointer to the decorator record if it could be retrieved; `nullptr` otherwise.
+ */
+template<typename ErrorInfo_T>
+inline typename ErrorInfo_T::ValueType const* getErrorInfo(Error const& e)
+{
+    return getErrorInfo<ErrorInfo_T>(e.exception());
+}
+
+/** Helper function for retrieving a diagnostic information string about the error.
+ */
+inline char const* getDiagnosticMessage(Error const& e)
+{
+    return getDiagnosticMessage(e.exception());
+}
+
+/** Result of an operation that may fail with an Error.
+ * This is a `std::expected` that can be converted back to exceptions at API boundaries with value_or_throw().
+ *
+ * @b Example
+   @code
+   Result<int> parseDigit(char c) {
+       if ((c < '0') || (c > '9')) { return GHULBUS_ERROR(Exceptions::InvalidArgument(), "Not a digit"); }
+       return c - '0';
+   }
+   int const d = parseDigit(c).value_or_throw();
+   @endcode
+ */
+template<typename T>
+class Result : public std::expected<T, Error> {
+public:
+    using std::expected<T, Error>::expected;
+
+    Result(std::expected<T, Error> const& rhs)
+        :std::expected<T, Error>(rhs)
+    {}
+
+    Result(std::expected<T, Error>&& rhs)
+        :std::expected<T, Error>(std::move(rhs))
+    {}
+
+    /** Returns the contained value or throws the exception of the contained error.
+     */
+    decltype(auto) value_or_throw() &
+    {
+        if (!this->has_value()) { Error(this->error()).raise(); }
+        if constexpr (!std::is_void_v<T>) { return **this; }
+    }
+
+    decltype(auto) value_or_throw() const&
+    {
+        if (!this->has_value()) { Error(this->error()).raise(); }
+        if constexpr (!std::is_void_v<T>) { return **this; }
+    }
+
+    decltype(auto) value_or_throw() &&
+    {
+        if (!this->has_value()) { std::move(this->error()).raise(); }
+        if constexpr (!std::is_void_v<T>) { return std::move(**this); }
+    }
+};
+}
+
+/** Create a Ghulbus::Error to return from a function returning a Result.
+ * The exception is decorated as if it was thrown with \ref GHULBUS_THROW.
+ * @param exc An exception object inheriting from Ghulbus::Exception.
+ * @param str A std::string or null-terminated C-string to attach to the exception as description.
+ *            Only string literals are stored by pointer; all other strings, including named char arrays, are copied.
+ */
+#define GHULBUS_ERROR(exc, str) \
+    ::std::unexpected<::GHULBUS_BASE_NAMESPACE::Error>(::GHULBUS_BASE_NAMESPACE::Error( (exc) <<      \
+        ::GHULBUS_BASE_NAMESPACE::Exception_Info::location(__FILE__,                                   \
+                                                           GHULBUS_INTERNAL_HELPER_FUNCTION_2,         \
+                                                           __LINE__) <<                                \
+        ::GHULBUS_BASE_NAMESPACE::impl::makeThrowDescription<decltype(str)>(str) ))
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_SLIDING_WINDOW_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_SLIDING_WINDOW_HPP
+
+/** @file
+ *
+ * @brief Sliding-window statistics over the most recent samples.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/Assert.hpp>
+#include <gbBase/FixedRing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+namespace impl
+{
+/** @cond
+ */
+/** Sum of all elements in s.
+ * Uses independent accumulators so that the compiler is free to vectorize the loop without -ffast-math.
+ */
+template<typename T>
+inline T sumSegment(std::span<T const> s) noexcept
+{
+    T acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 <= s.size(); i += 4) {
+        acc[0] += s[i];
+        acc[1] += s[i + 1];
+        acc[2] += s[i + 2];
+        acc[3] += s[i + 3];
+    }
+    for (; i < s.size(); ++i) { acc[0] += s[i]; }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/** Sum of squared deviations from mean of all elements in s.
+ * @copydetails sumSegment
+ */
+template<typename T>
+inline T sumSquaredDeviationsSegment(std::span<T const> s, T mean) noexcept
+{
+    T acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 <= s.size(); i += 4) {
+        T const d0 = s[i] - mean;
+        T const d1 = s[i + 1] - mean;
+        T const d2 = s[i + 2] - mean;
+        T const d3 = s[i + 3] - mean;
+        acc[0] += d0 * d0;
+        acc[1] += d1 * d1;
+        acc[2] += d2 * d2;
+        acc[3] += d3 * d3;
+    }
+    for (; i < s.size(); ++i) {
+        T const d = s[i] - mean;
+        acc[0] += d * d;
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+/** @endcond
+ */
+}
+
+/** Statistics over the last N samples of a stream of floating point values.
+ * Sum, mean and variance are maintained as running values and can be queried in O(1).
+ * Minimum and maximum are tracked through monotonic queues in O(1) amortized time per sample.
+ * Percentiles are computed on demand in O(N).
+ * No memory is allocated after construction.
+ * @note The running values accumulate rounding errors over time. Use recalculate() to periodically
+ *       recompute them exactly from the stored samples if the window is used for a very long time.
+ */
+template<typename T = double>
+class SlidingWindow {
+    static_assert(std::is_floating_point_v<T>, "SlidingWindow only supports floating point types.");
+public:
+    using value_type = T;
+    using size_type = typename FixedRing<T>::size_type;
+private:
+    struct QueueEntry {
+        std::uint64_t sequence;
+        T value;
+    };
+    FixedRing<T> m_samples;
+    FixedRing<QueueEntry> m_minQueue;       ///< candidates for the minimum, values strictly increasing
+    FixedRing<QueueEntry> m_maxQueue;       ///< candidates for the maximum, values strictly decreasing
+    std::uint64_t m_sequence;               ///< total number of samples pushed so far
+    T m_sum;
+    T m_mean;
+    T m_m2;                                 ///< sum of squared deviations from the mean
+    std::vector<T> mutable m_scratch;       ///< preallocated storage for percentile()
+public:
+    /** Constructor.
+     * @param[in] window_size Number of most recent samples that are considered for the statistics.
+     * \pre window_size > 0
+     */
+    explicit SlidingWindow(size_type window_size)
+        :m_samples(window_size), m_minQueue(window_size), m_maxQueue(window_size),
+         m_sequence(0), m_sum(0), m_mean(0), m_m2(0)
+    {
+        m_scratch.reserve(window_size);
+    }
+
+    /** Adds a new sample to the window.
+     * If the window is full, the oldest sample is evicted.
+     */
+    void push(T value)
+    {
+        if (m_samples.full()) {
+            std::uint64_t const evicted_sequence = m_sequence - m_samples.available();
+            T const evicted = m_samples.pop_front();
+            if (m_minQueue.front().sequence == evicted_sequence) { m_minQueue.pop_front(); }
+            if (m_maxQueue.front().sequence == evicted_sequence) { m_maxQueue.pop_front(); }
+            removeFromRunningValues(evicted);
+        }
+        m_samples.push_back(value);
+        addToRunningValues(value);
+
+        while (!m_minQueue.empty() && !(m_minQueue.back().value < value)) { m_minQueue.pop_back(); }
+        m_minQueue.push_back(QueueEntry{ m_sequence, value });
+        while (!m_maxQueue.empty() && !(value < m_maxQueue.back().value)) { m_maxQueue.pop_back(); }
+        m_maxQueue.push_back(QueueEntry{ m_sequence, value });
+        ++m_sequence;
+    }
+
+    /** Removes all samples from the window.
+     */
+    void clear() noexcept
+    {
+        while (!m_samples.empty()) { m_samples.pop_front(); }
+        while (!m_minQueue.empty()) { m_minQueue.pop_front(); }
+        while (!m_maxQueue.empty()) { m_maxQueue.pop_front(); }
+        m_sum = T(0);
+        m_mean = T(0);
+        m_m2 = T(0);
+    }
+
+    /** Maximum number of samples considered for the statistics.
+     */
+    size_type capacity() const noexcept
+    {
+        return m_samples.capacity();
+    }
+
+    /** Number of samples currently in the window.
+     */
+    size_type size() const noexcept
+    {
+        return m_samples.available();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_samples.empty();
+    }
+
+    bool full() const noexcept
+    {
+        return m_samples.full();
+    }
+
+    /** Access to the underlying samples, oldest first.
+     */
+    FixedRing<T> const& samples() const noexcept
+    {
+        return m_samples;
+    }
+
+    /** Sum of all samples in the window.
+     */
+    T sum() const noexcept
+    {
+        return m_sum;
+    }
+
+    /** Arithmetic mean of all samples in the window.
+     * \pre !empty()
+     */
+    T mean() const noexcept
+    {
+        GHULBUS_PRECONDITION(!empty());
+        return m_mean;
+    }
+
+    /** Population variance of all samples in the window.
+     * \pre !empty()
+     */
+    T variance() const noexcept
+    {
+        GHULBUS_PRECONDITION(!empty());
+        return std::max(m_m2, T(0)) / static_cast<T>(size());
+    }
+
+    /** Population standard deviation of all samples in the window.
+     * \pre !empty()
+     */
+    T stddev() const noexcept
+    {
+        return std::sqrt(variance());
+    }
+
+    /** Smallest sample in the window.
+     * \pre !empty()
+     */
+    T min() const noexcept
+    {
+        GHULBUS_PRECONDITION(!empty());
+        return m_minQueue.front().value;
+    }
+
+    /** Largest sample in the window.
+     * \pre !empty()
+     */
+    T max() const noexcept
+    {
+        GHULBUS_PRECONDITION(!empty());
+        return m_maxQueue.front().value;
+    }
+
+    /** Computes the p-th percentile of the samples in the window.
+     * Values between two samples are linearly interpolated.
+     * @param[in] p Percentile in the range [0, 1], e.g. 0.99 for the 99th percentile.
+     * @note This function uses internal scratch storage and must not be called concurrently on the same object.
+     * \pre !empty()
+     * \pre p >= 0 && p <= 1
+     */
+    T percentile(double p) const
+    {
+        GHULBUS_PRECONDITION(!empty());
+        GHULBUS_PRECONDITION((p >= 0.0) && (p <= 1.0));
+        auto const one = m_samples.array_one();
+        auto const two = m_samples.array_two();
+        m_scratch.resize(size());
+        std::copy(two.begin(), two.end(), std::copy(one.begin(), one.end(), m_scratch.begin()));
+
+        double const rank = p * static_cast<double>(size() - 1);
+        auto const lower_idx = static_cast<size_type>(rank);
+        auto const lower_it = m_scratch.begin() + lower_idx;
+        std::nth_element(m_scratch.begin(), lower_it, m_scratch.end());
+        T const lower = *lower_it;
+        if (lower_idx + 1 == size()) { return lower; }
+        T const upper = *std::min_element(lower_it + 1, m_scratch.end());
+        return lower + static_cast<T>(rank - static_cast<double>(lower_idx)) * (upper - lower);
+    }
+
+    /** Recomputes sum, mean and variance from the stored samples.
+     * This eliminates rounding errors that accumulated in the running values. Runs in O(N).
+     */
+    void recalculate() noexcept
+    {
+        if (empty()) {
+            m_sum = m_mean = m_m2 = T(0);
+            return;
+        }
+        auto const one = m_samples.array_one();
+        auto const two = m_samples.array_two();
+        m_sum = impl::sumSegment<T>(one) + impl::sumSegment<T>(two);
+        m_mean = m_sum / static_cast<T>(size());
+        m_m2 = impl::sumSquaredDeviationsSegment<T>(one, m_mean) + impl::sumSquaredDeviationsSegment<T>(two, m_mean);
+    }
+private:
+    void addToRunningValues(T value) noexcept
+    {
+        // Welford's online algorithm; m_samples already contains the new value
+        T const n = static_cast<T>(m_samples.available());
+        T const delta = value - m_mean;
+        m_sum += value;
+        m_mean += delta / n;
+        m_m2 += delta * (value - m_mean);
+    }
+
+    void removeFromRunningValues(T value) noexcept
+    {
+        // inverse of Welford's algorithm; m_samples already had the value removed
+        auto const n = m_samples.available();
+        if (n == 0) {
+            m_sum = m_mean = m_m2 = T(0);
+            return;
+        }
+        T const delta = value - m_mean;
+        m_sum -= value;
+        m_mean -= delta / static_cast<T>(n);
+        m_m2 -= delta * (value - m_mean);
+    }
+};
+
+}
+
+#endif
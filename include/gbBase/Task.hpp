@@ -0,0 +1,400 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_TASK_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_TASK_HPP
+
+/** @file
+ *
+ * @brief Coroutine task type.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/AnyInvocable.hpp>
+#include <gbBase/Assert.hpp>
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+template<typename T = void>
+class Task;
+
+namespace impl {
+/** Allocates memory for a coroutine frame.
+ * Frames are recycled through thread-local free lists, one for each size class. Memory returned by
+ * deallocateCoroutineFrame() is put on the free list of the calling thread.
+ */
+GHULBUS_BASE_API void* allocateCoroutineFrame(std::size_t size);
+GHULBUS_BASE_API void deallocateCoroutineFrame(void* p, std::size_t size) noexcept;
+
+class TaskPromiseBase {
+private:
+    std::coroutine_handle<> m_continuation;
+public:
+    static void* operator new(std::size_t size)
+    {
+        return allocateCoroutineFrame(size);
+    }
+
+    static void operator delete(void* p, std::size_t size) noexcept
+    {
+        deallocateCoroutineFrame(p, size);
+    }
+
+    /** Upon completion, transfers control to the awaiting coroutine, if any.
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+        {
+            std::coroutine_handle<> const continuation = h.promise().m_continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept
+    {
+        m_continuation = continuation;
+    }
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase {
+private:
+    std::variant<std::monostate, T, std::exception_ptr> m_result;
+public:
+    Task<T> get_return_object() noexcept;
+
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U&&, T>>>
+    void return_value(U&& v) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+    {
+        m_result.template emplace<1>(std::forward<U>(v));
+    }
+
+    void unhandled_exception() noexcept
+    {
+        m_result.template emplace<2>(std::current_exception());
+    }
+
+    T result()
+    {
+        if (m_result.index() == 2) { std::rethrow_exception(std::get<2>(m_result)); }
+        return std::move(std::get<1>(m_result));
+    }
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase {
+private:
+    std::exception_ptr m_exception;
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept
+    {}
+
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    void result()
+    {
+        if (m_exception) { std::rethrow_exception(m_exception); }
+    }
+};
+}
+
+/** A lazily started coroutine producing a value of type T.
+ * A task does not start executing until it is awaited with `co_await`. The awaiting coroutine is suspended and
+ * resumed once the task completes. Control is passed between the coroutines by symmetric transfer, so long chains
+ * of tasks that complete synchronously do not grow the stack.
+ * Exceptions escaping the coroutine body are rethrown in the awaiting coroutine.
+ *
+ * Coroutine frames are allocated through a recycling frame allocator that keeps freed frames in thread-local
+ * free lists.
+ *
+ * Use resumeOn() to continue a coroutine on an executor and syncWait() to block on a task from regular code.
+ *
+ * @b Example
+   @code
+   Task<int> computeAnswer(ThreadPool& pool) {
+       co_await resumeOn(pool);
+       co_return 42;
+   }
+   Task<void> printAnswer(ThreadPool& pool) {
+       std::cout << co_await computeAnswer(pool) << std::endl;
+   }
+   syncWait(printAnswer(pool));
+   @endcode
+ */
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = impl::TaskPromise<T>;
+    using value_type = T;
+private:
+    std::coroutine_handle<promise_type> m_handle;
+public:
+    Task() noexcept = default;
+
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept
+        :m_handle(h)
+    {}
+
+    ~Task()
+    {
+        if (m_handle) { m_handle.destroy(); }
+    }
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    Task(Task&& rhs) noexcept
+        :m_handle(std::exchange(rhs.m_handle, nullptr))
+    {}
+
+    Task& operator=(Task&& rhs) noexcept
+    {
+        if (&rhs != this) {
+            if (m_handle) { m_handle.destroy(); }
+            m_handle = std::exchange(rhs.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    /** Checks whether the task refers to a coroutine.
+     */
+    bool valid() const noexcept
+    {
+        return static_cast<bool>(m_handle);
+    }
+
+    /** Checks whether the coroutine has run to completion.
+     * \pre valid()
+     */
+    bool done() const noexcept
+    {
+        GHULBUS_PRECONDITION_DBG(valid());
+        return m_handle.done();
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept
+            {
+                return handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().setContinuation(awaiting);
+                return handle;
+            }
+
+            T await_resume()
+            {
+                return handle.promise().result();
+            }
+        };
+        GHULBUS_PRECONDITION_DBG(valid());
+        return Awaiter{ m_handle };
+    }
+};
+
+namespace impl {
+template<typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/** Coroutine used by syncWait() to drive a task and signal its completion.
+ */
+class SyncWaiter {
+public:
+    struct promise_type {
+        std::mutex* mutex = nullptr;
+        std::condition_variable* condvar = nullptr;
+        bool* done = nullptr;
+
+        SyncWaiter get_return_object() noexcept
+        {
+            return SyncWaiter(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() const noexcept
+        {
+            struct Signal {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+                {
+                    // notify while holding the lock, as the waiting thread destroys everything once it sees done
+                    promise_type& p = h.promise();
+                    std::lock_guard lk(*p.mutex);
+                    *p.done = true;
+                    p.condvar->notify_one();
+                }
+                void await_resume() const noexcept {}
+            };
+            return Signal{};
+        }
+
+        void return_void() noexcept
+        {}
+
+        void unhandled_exception() noexcept
+        {
+            // unreachable; makeSyncWaiter() catches all exceptions
+            std::terminate();
+        }
+    };
+private:
+    std::coroutine_handle<promise_type> m_handle;
+public:
+    explicit SyncWaiter(std::coroutine_handle<promise_type> h) noexcept
+        :m_handle(h)
+    {}
+
+    ~SyncWaiter()
+    {
+        m_handle.destroy();
+    }
+
+    SyncWaiter(SyncWaiter const&) = delete;
+    SyncWaiter& operator=(SyncWaiter const&) = delete;
+
+    void run()
+    {
+        std::mutex mutex;
+        std::condition_variable condvar;
+        bool done = false;
+        promise_type& p = m_handle.promise();
+        p.mutex = &mutex;
+        p.condvar = &condvar;
+        p.done = &done;
+        m_handle.resume();
+        std::unique_lock lk(mutex);
+        condvar.wait(lk, [&done]() { return done; });
+    }
+};
+
+template<typename T>
+struct SyncWaitResult {
+    std::optional<T> value;
+    std::exception_ptr exception;
+
+    T get()
+    {
+        if (exception) { std::rethrow_exception(exception); }
+        return std::move(*value);
+    }
+};
+
+template<>
+struct SyncWaitResult<void> {
+    std::exception_ptr exception;
+
+    void get()
+    {
+        if (exception) { std::rethrow_exception(exception); }
+    }
+};
+
+template<typename T>
+SyncWaiter makeSyncWaiter(Task<T> task, SyncWaitResult<T>& result)
+{
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+        } else {
+            result.value.emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        result.exception = std::current_exception();
+    }
+}
+}
+
+/** Blocks the calling thread until the task has completed and returns its result.
+ * The task is started on the calling thread. It may move to other threads, e.g. using resumeOn().
+ * If the task exits with an exception, that exception is rethrown.
+ * @attention Never call this from a thread that the task depends on for making progress, such as a worker thread
+ *            of the pool that it resumes on, as this might deadlock.
+ */
+template<typename T>
+T syncWait(Task<T> task)
+{
+    GHULBUS_PRECONDITION(task.valid());
+    impl::SyncWaitResult<T> result;
+    impl::makeSyncWaiter(std::move(task), result).run();
+    return result.get();
+}
+
+/** Returns an awaitable that resumes the awaiting coroutine on the given executor.
+ * @param[in] executor Any object with a member function `post()` accepting an `AnyInvocable<void()>`,
+ *                     like ThreadPool. The executor must outlive the suspended coroutine.
+ */
+template<typename Executor>
+auto resumeOn(Executor& executor) noexcept
+{
+    struct Awaiter {
+        Executor* executor;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            executor->post(AnyInvocable<void()>([h]() { h.resume(); }));
+        }
+
+        void await_resume() const noexcept
+        {}
+    };
+    return Awaiter{ &executor };
+}
+
+}
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_THREAD_POOL_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_THREAD_POOL_HPP
+
+/** @file
+ *
+ * @brief Work-stealing thread pool.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/AnyInvocable.hpp>
+#include <gbBase/Assert.hpp>
+#include <gbBase/Channel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+class ThreadPool;
+
+namespace impl {
+/** Completion state shared between a task and its TaskFuture.
+ */
+class TaskStateBase {
+private:
+    static constexpr std::uint32_t pending = 0;
+    static constexpr std::uint32_t pending_with_waiters = 1;
+    static constexpr std::uint32_t ready = 2;
+
+    std::atomic<std::uint32_t> m_status;
+    std::exception_ptr m_exception;
+public:
+    TaskStateBase() noexcept
+        :m_status(pending)
+    {}
+
+    bool isReady() const noexcept
+    {
+        return m_status.load(std::memory_order_acquire) == ready;
+    }
+
+    /** Blocks until markReady() was called.
+     * The waiting thread is only notified if it registered itself as waiter.
+     */
+    void wait() noexcept
+    {
+        std::uint32_t status = m_status.load(std::memory_order_acquire);
+        while (status != ready) {
+            if ((status == pending) &&
+                !m_status.compare_exchange_weak(status, pending_with_waiters, std::memory_order_acquire))
+            {
+                continue;
+            }
+            m_status.wait(pending_with_waiters, std::memory_order_acquire);
+            status = m_status.load(std::memory_order_acquire);
+        }
+    }
+
+    void markReady() noexcept
+    {
+        if (m_status.exchange(ready, std::memory_order_acq_rel) == pending_with_waiters) {
+            m_status.notify_all();
+        }
+    }
+
+    /** \pre markReady() was not called yet.
+     */
+    void setException(std::exception_ptr e) noexcept
+    {
+        m_exception = std::move(e);
+    }
+
+    /** \pre isReady()
+     */
+    void rethrowException() const
+    {
+        if (m_exception) { std::rethrow_exception(m_exception); }
+    }
+};
+
+template<typename T>
+class TaskState : public TaskStateBase {
+public:
+    std::optional<T> value;
+};
+
+template<>
+class TaskState<void> : public TaskStateBase {
+};
+
+/** State shared by a group of tasks that completes once all tasks of the group have completed.
+ */
+class TaskGroupState : public TaskState<void> {
+private:
+    std::atomic<std::size_t> m_remaining;
+    std::atomic<bool> m_hasException;
+public:
+    explicit TaskGroupState(std::size_t n_tasks) noexcept
+        :m_remaining(n_tasks), m_hasException(false)
+    {
+        if (n_tasks == 0) { markReady(); }
+    }
+
+    /** Only the first exception reported by any of the tasks is kept.
+     */
+    void reportException(std::exception_ptr e) noexcept
+    {
+        if (!m_hasException.exchange(true, std::memory_order_relaxed)) {
+            setException(std::move(e));
+        }
+    }
+
+    void taskCompleted() noexcept
+    {
+        if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            markReady();
+        }
+    }
+};
+}
+
+/** A lightweight future for the result of a task submitted to a ThreadPool.
+ * Waiting on a future from one of the pool's worker threads does not block the worker as long as there are
+ * other tasks for it to execute. This allows tasks to submit subtasks and wait for their results.
+ */
+template<typename T>
+class TaskFuture {
+    friend class ThreadPool;
+private:
+    std::shared_ptr<impl::TaskState<T>> m_state;
+    ThreadPool* m_pool = nullptr;
+
+    TaskFuture(std::shared_ptr<impl::TaskState<T>> state, ThreadPool& pool) noexcept
+        :m_state(std::move(state)), m_pool(&pool)
+    {}
+public:
+    TaskFuture() noexcept = default;
+
+    /** Checks whether the future refers to a task.
+     */
+    bool valid() const noexcept
+    {
+        return m_state != nullptr;
+    }
+
+    /** Checks whether the task has completed.
+     * \pre valid()
+     */
+    bool ready() const noexcept
+    {
+        GHULBUS_PRECONDITION_DBG(valid());
+        return m_state->isReady();
+    }
+
+    /** Blocks until the task has completed.
+     * \pre valid()
+     */
+    void wait() const;
+
+    /** Waits for the task to complete and retrieves its result.
+     * If the task threw an exception, that exception is rethrown.
+     * \pre valid()
+     */
+    T get()
+    {
+        wait();
+        m_state->rethrowException();
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*m_state->value);
+        }
+    }
+};
+
+/** A thread pool with work-stealing scheduling.
+ * Every worker thread owns a Chase-Lev deque. Tasks submitted from a worker thread are pushed to that worker's
+ * deque, which it processes in LIFO order without any locking. The tasks are stored in nodes from a per-worker
+ * pool that are recycled after the task has run, so that submitting from a worker does not allocate once the
+ * pool has warmed up. Tasks submitted from outside the pool are stored by value in a bounded injection Channel
+ * of `injection_queue_capacity` elements; submitting from outside blocks while that channel is full. Workers
+ * that run out of work take tasks from the injection queue or steal the oldest tasks from the deques of randomly
+ * chosen other workers.
+ *
+ * Idle workers are parked using `std::atomic::wait` and are only notified if there are parked workers.
+ *
+ * On destruction, all tasks that were already submitted are executed before the worker threads are joined.
+ */
+class ThreadPool {
+public:
+    using Task = AnyInvocable<void()>;
+
+    /** Maximum number of tasks submitted from outside the pool that may be waiting for execution.
+     */
+    static constexpr std::size_t injection_queue_capacity = 1024;
+private:
+    struct Worker;
+
+    std::unique_ptr<Worker[]> m_workers;
+    std::size_t m_nWorkers;
+    std::vector<std::thread> m_threads;
+    Channel<Task> m_injectionQueue;
+    alignas(64) std::atomic<std::uint32_t> m_wakeSignal;
+    std::atomic<std::uint32_t> m_sleeping;
+    std::atomic<bool> m_stop;
+public:
+    /** Constructs a pool with one worker thread per hardware thread.
+     */
+    GHULBUS_BASE_API ThreadPool();
+
+    /** Constructs a pool with the given number of worker threads.
+     * \pre n_threads > 0
+     */
+    GHULBUS_BASE_API explicit ThreadPool(std::size_t n_threads);
+
+    /** Destructor.
+     * Executes all outstanding tasks and joins the worker threads.
+     * \pre No thread outside the pool submits tasks during destruction.
+     */
+    GHULBUS_BASE_API ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    /** Number of worker threads.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_nWorkers;
+    }
+
+    /** Checks whether the calling thread is one of the worker threads of this pool.
+     */
+    GHULBUS_BASE_API bool isWorkerThread() const noexcept;
+
+    /** Submits a task for execution without tracking its completion.
+     * If the task throws, std::terminate is called.
+     * \pre !task.empty()
+     */
+    GHULBUS_BASE_API void post(Task task);
+
+    /** Submits a batch of tasks for execution without tracking their completion.
+     * This is more efficient than posting the tasks individually. The tasks are moved from.
+     * If a task throws, std::terminate is called.
+     */
+    GHULBUS_BASE_API void post(std::span<Task> tasks);
+
+    /** Submits a task for execution.
+     * @return A future for the result of the task.
+     */
+    template<typename F>
+    TaskFuture<std::invoke_result_t<std::decay_t<F>&>> submit(F&& f)
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>&>;
+        auto state = std::make_shared<impl::TaskState<Result>>();
+        post([state, f = std::forward<F>(f)]() mutable {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    f();
+                } else {
+                    state->value.emplace(f());
+                }
+            } catch (...) {
+                state->setException(std::current_exception());
+            }
+            state->markReady();
+        });
+        return TaskFuture<Result>(std::move(state), *this);
+    }
+
+    /** Submits all callables from the range [first, last) for execution.
+     * The callables are moved from.
+     * @return A future that becomes ready once all tasks have completed. If tasks threw exceptions, the future
+     *         will rethrow the first of them.
+     */
+    template<typename InputIterator>
+    TaskFuture<void> bulk_submit(InputIterator first, InputIterator last)
+    {
+        using Callable = typename std::iterator_traits<InputIterator>::value_type;
+        std::vector<Callable> callables(std::make_move_iterator(first), std::make_move_iterator(last));
+        std::vector<Task> tasks;
+        tasks.reserve(callables.size());
+        auto state = std::make_shared<impl::TaskGroupState>(callables.size());
+        for (auto& c : callables) {
+            tasks.emplace_back([state, f = std::move(c)]() mutable {
+                try {
+                    f();
+                } catch (...) {
+                    state->reportException(std::current_exception());
+                }
+                state->taskCompleted();
+            });
+        }
+        post(tasks);
+        return TaskFuture<void>(std::move(state), *this);
+    }
+
+    /** Invokes f(i) for every i in [first, last) in parallel.
+     * The range is divided into chunks of `grain` consecutive indices that are distributed dynamically among
+     * the worker threads and the calling thread. Choose the grain large enough to amortize the scheduling
+     * overhead. Blocks until all invocations have completed.
+     * If an invocation throws, remaining chunks are skipped and the first exception is rethrown.
+     * \pre grain > 0
+     */
+    template<typename F>
+    void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& f)
+    {
+        GHULBUS_PRECONDITION(grain > 0);
+        if (first >= last) { return; }
+        std::size_t const n_chunks = (last - first - 1) / grain + 1;
+        std::atomic<std::size_t> next_chunk(0);
+        std::atomic<bool> cancelled(false);
+        auto const run_chunks = [&]() {
+            for (std::size_t c; !cancelled.load(std::memory_order_relaxed) &&
+                                ((c = next_chunk.fetch_add(1, std::memory_order_relaxed)) < n_chunks);)
+            {
+                std::size_t const chunk_first = first + c * grain;
+                std::size_t const chunk_last = chunk_first + std::min(grain, last - chunk_first);
+                try {
+                    for (std::size_t i = chunk_first; i < chunk_last; ++i) { f(i); }
+                } catch (...) {
+                    cancelled.store(true, std::memory_order_relaxed);
+                    throw;
+                }
+            }
+        };
+        std::size_t const n_helpers = std::min(n_chunks - 1, m_nWorkers);
+        std::vector<std::reference_wrapper<decltype(run_chunks) const>> helpers(n_helpers, std::cref(run_chunks));
+        TaskFuture<void> helpers_done = bulk_submit(helpers.begin(), helpers.end());
+        std::exception_ptr exception;
+        try {
+            run_chunks();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        // helpers reference the stack of this function, so wait for them even in case of an exception
+        helpers_done.wait();
+        if (exception) { std::rethrow_exception(exception); }
+        helpers_done.get();
+    }
+private:
+    template<typename T>
+    friend class TaskFuture;
+
+    GHULBUS_BASE_API void waitFor(impl::TaskStateBase& state);
+    void pushLocal(Task& task);
+    void inject(Task& task);
+    bool tryRunTask(std::size_t worker_index);
+    void workerMain(std::size_t worker_index);
+    void wakeWorkers(std::size_t n);
+    bool hasWork() const noexcept;
+};
+
+template<typename T>
+void TaskFuture<T>::wait() const
+{
+    GHULBUS_PRECONDITION_DBG(valid());
+    m_pool->waitFor(*m_state);
+}
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_TIMER_WHEEL_HPP
+#define GHULBUS_LIBRARY_INCLUDE_GUARD_BASE_TIMER_WHEEL_HPP
+
+/** @file
+ *
+ * @brief Hierarchical timing wheel.
+ * @author Andreas Weis (der_ghulbus@ghulbus-inc.de)
+ */
+
+#include <gbBase/config.hpp>
+#include <gbBase/AnyInvocable.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+/** A hierarchical timing wheel for managing large numbers of timeouts.
+ * Time is measured in abstract ticks; it is up to the user to decide how long a tick is and to call tick() or
+ * advance() accordingly. Scheduling and cancelling a timer are O(1), as is processing a tick, not counting the
+ * callbacks that expire during that tick.
+ *
+ * Timers are kept in intrusive doubly-linked lists, one for each slot of the wheel. The lowest level of the wheel
+ * has 256 slots of one tick each, the four upper levels have 64 slots each, covering 2^14, 2^20, 2^26 and 2^32
+ * ticks respectively. Timers further in the future are parked in the topmost level until they come into range.
+ * Whenever the lowest level wraps around, timers from the upper levels are cascaded down.
+ *
+ * Timer nodes are recycled through a free list, so memory is only allocated if the number of concurrently
+ * active timers exceeds all previous peaks (see also reserve()).
+ *
+ * The wheel is not thread-safe.
+ */
+class TimerWheel {
+public:
+    using Tick = std::uint64_t;
+    using Callback = AnyInvocable<void()>;
+
+    /** Handle for a scheduled timer that can be used for cancelling it.
+     * A handle remains safe to use after the timer has expired or was cancelled.
+     */
+    struct TimerId {
+        std::uint32_t index = 0xffffffff;
+        std::uint32_t generation = 0;
+
+        friend bool operator==(TimerId const&, TimerId const&) = default;
+    };
+private:
+    static constexpr std::uint32_t invalid_index = 0xffffffff;
+    static constexpr int root_bits = 8;
+    static constexpr int level_bits = 6;
+    static constexpr int n_levels = 4;
+    static constexpr std::size_t root_size = std::size_t(1) << root_bits;
+    static constexpr std::size_t level_size = std::size_t(1) << level_bits;
+    static constexpr std::size_t n_buckets = root_size + n_levels * level_size;
+    static constexpr std::uint32_t pending_bucket = n_buckets;      ///< expired timers waiting for their callback
+    static constexpr std::uint32_t running_bucket = n_buckets + 1;  ///< periodic timer whose callback is running
+    static constexpr std::uint32_t free_bucket = n_buckets + 2;
+
+    struct Node {
+        Tick expires;
+        Tick period;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t bucket;
+        std::uint32_t generation;
+        Callback callback;
+    };
+
+    std::vector<Node> m_nodes;
+    std::array<std::uint32_t, n_buckets + 1> m_heads;
+    std::uint32_t m_freeList;
+    Tick m_now;
+    std::size_t m_size;
+public:
+    /** Constructs an empty wheel with the current time 0.
+     */
+    GHULBUS_BASE_API TimerWheel();
+
+    /** Constructs an empty wheel with the given current time.
+     */
+    GHULBUS_BASE_API explicit TimerWheel(Tick now);
+
+    GHULBUS_BASE_API ~TimerWheel();
+
+    TimerWheel(TimerWheel const&) = delete;
+    TimerWheel& operator=(TimerWheel const&) = delete;
+
+    /** Schedules a callback to be invoked after the given number of ticks.
+     * @param[in] delay Number of ticks after which the callback is invoked. A delay of 0 is treated as 1,
+     *                  i.e. the callback will be invoked on the next tick.
+     * @param[in] callback The function to invoke. Must not be empty.
+     * @return A handle that can be used to cancel the timer.
+     */
+    GHULBUS_BASE_API TimerId schedule(Tick delay, Callback callback);
+
+    /** Schedules a callback to be invoked periodically.
+     * The callback is first invoked after `period` ticks and then every `period` ticks until it is cancelled.
+     * This is useful for things like periodically flushing buffers.
+     * @param[in] period Number of ticks between invocations. Must not be 0.
+     * @param[in] callback The function to invoke. Must not be empty.
+     * @return A handle that can be used to cancel the timer.
+     */
+    GHULBUS_BASE_API TimerId schedulePeriodic(Tick period, Callback callback);
+
+    /** Cancels a timer.
+     * Cancelling a timer from within a timer callback, including its own, is allowed.
+     * @return true if the timer was active and has been cancelled; false if the timer has already expired or
+     *         was cancelled before.
+     */
+    GHULBUS_BASE_API bool cancel(TimerId id);
+
+    /** Advances the wheel by one tick and invokes all callbacks that expire on that tick.
+     * Callbacks may schedule and cancel timers.
+     * If a callback throws, the exception is propagated to the caller. Timers that expired on the same tick
+     * but did not yet get invoked will be invoked on the next call to tick() or advance().
+     * @return The number of callbacks that were invoked.
+     */
+    GHULBUS_BASE_API std::size_t tick();
+
+    /** Advances the wheel by the given number of ticks.
+     * This is equivalent to calling tick() `ticks` times.
+     * @return The number of callbacks that were invoked.
+     */
+    GHULBUS_BASE_API std::size_t advance(Tick ticks);
+
+    /** Preallocates storage for the given number of concurrently active timers.
+     */
+    GHULBUS_BASE_API void reserve(std::size_t n_timers);
+
+    /** The current time of the wheel, in ticks.
+     */
+    Tick now() const noexcept
+    {
+        return m_now;
+    }
+
+    /** Number of active timers.
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+private:
+    std::uint32_t allocateNode();
+    void freeNode(std::uint32_t index) noexcept;
+    void link(std::uint32_t index, std::uint32_t bucket) noexcept;
+    void unlink(std::uint32_t index) noexcept;
+    void insert(std::uint32_t index) noexcept;
+    void cascade(int level, std::size_t slot) noexcept;
+    std::size_t runPending();
+};
+
+}
+
+#endif
@@ -1,7 +1,10 @@
 #include <gbBase/Assert.hpp>
 
 #include <gbBase/Exception.hpp>
+#include <gbBase/Log.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
@@ -13,6 +16,30 @@ namespace GHULBUS_BASE_NAMESPACE
 namespace
 {
 Assert::Handler g_AssertionHandler(&Assert::failAbort);
+Assert::ReturnBehavior g_AssertionHandlerReturnBehavior(Assert::ReturnBehavior::Abort);
+std::atomic<std::uint32_t> g_LogAndContinueRateLimit(10);
+
+/* Site::logState packs the minute of the last log in the upper bits and the number of logs within that minute
+ * in the lower bits. A state of 0 means the site was never logged.
+ */
+constexpr int log_state_count_bits = 24;
+constexpr std::uint64_t log_state_count_mask = (std::uint64_t(1) << log_state_count_bits) - 1;
+
+bool shouldLog(Assert::Site& site)
+{
+    auto const minute = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    std::uint64_t const limit =
+        std::min<std::uint64_t>(g_LogAndContinueRateLimit.load(std::memory_order_relaxed), log_state_count_mask);
+    std::uint64_t state = site.logState.load(std::memory_order_relaxed);
+    for (;;) {
+        std::uint64_t const count = ((state >> log_state_count_bits) == minute) ? (state & log_state_count_mask) : 0;
+        // the first failure is always logged
+        if ((state != 0) && (count >= limit)) { return false; }
+        std::uint64_t const new_state = (minute << log_state_count_bits) | (count + 1);
+        if (site.logState.compare_exchange_weak(state, new_state, std::memory_order_relaxed)) { return true; }
+    }
+}
 
 std::ostream& operator<<(std::ostream& os, Assert::HandlerParameters const& handler_param)
 {
@@ -34,10 +61,11 @@ std::string toString(Assert::HandlerParameters const& handler_param)
 
 namespace Assert
 {
-void setAssertionHandler(Handler handler) noexcept
+void setAssertionHandler(Handler handler, ReturnBehavior return_behavior) noexcept
 {
     auto& static_handler = g_AssertionHandler;
     static_handler = handler;
+    g_AssertionHandlerReturnBehavior = return_behavior;
 }
 
 Handler getAssertionHandler() noexcept
@@ -52,6 +80,24 @@ void assertionFailed(HandlerParameters const& param)
     std::abort();
 }
 
+ReturnBehavior getAssertionHandlerReturnBehavior() noexcept
+{
+    return g_AssertionHandlerReturnBehavior;
+}
+
+void assertionFailed(Site& site, char const* message)
+{
+    site.failures.fetch_add(1, std::memory_order_relaxed);
+    getAssertionHandler()(HandlerParameters{ site.file, site.line, site.function, site.condition, message, &site });
+    if (getAssertionHandlerReturnBehavior() != ReturnBehavior::Continue) { std::abort(); }
+}
+
+void unreachableCodeReached(Site& site, char const* message)
+{
+    site.failures.fetch_add(1, std::memory_order_relaxed);
+    assertionFailed(HandlerParameters{ site.file, site.line, site.function, site.condition, message, &site });
+}
+
 void failAbort(HandlerParameters const& param)
 {
     // keep the error message in a string for easy inspection by the debugger
@@ -76,5 +122,20 @@ void failThrow(HandlerParameters const& param)
                                        (param.message ? " - " : "") + (param.message ? param.message : ""));
     throw exc;
 }
+
+void failLogAndContinue(HandlerParameters const& param)
+{
+    if (!param.site) {
+        GHULBUS_LOG(Error, toString(param));
+    } else if (shouldLog(*param.site)) {
+        GHULBUS_LOG(Error, toString(param) << " (failed "
+                           << param.site->failures.load(std::memory_order_relaxed) << " times)");
+    }
+}
+
+void setLogAndContinueRateLimit(std::uint32_t max_logs_per_minute) noexcept
+{
+    g_LogAndContinueRateLimit.store(max_logs_per_minute, std::memory_order_relaxed);
+}
 }
 }
@@ -0,0 +1,417 @@
+#include <gbBase/Exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(_WIN32)
+#   include <Windows.h>
+#elif __has_include(<execinfo.h>)
+#   include <execinfo.h>
+#   define GHULBUS_INTERNAL_HAS_EXECINFO
+#endif
+
+#if defined(__GLIBC__) && (defined(__x86_64__) || defined(__aarch64__))
+#   include <pthread.h>
+#   define GHULBUS_INTERNAL_HAS_FRAME_POINTER_WALK
+#endif
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+namespace
+{
+std::atomic<bool> g_stackTraceCaptureEnabled{ true };
+
+#if defined(GHULBUS_INTERNAL_HAS_FRAME_POINTER_WALK)
+/** Address one past the highest address of the stack of the calling thread, or 0 if it is unknown.
+ */
+std::uintptr_t currentStackEnd() noexcept
+{
+    thread_local std::uintptr_t const stack_end = []() -> std::uintptr_t {
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) != 0) { return 0; }
+        void* stack_addr = nullptr;
+        std::size_t stack_size = 0;
+        int const res = pthread_attr_getstack(&attr, &stack_addr, &stack_size);
+        pthread_attr_destroy(&attr);
+        return (res == 0) ? (reinterpret_cast<std::uintptr_t>(stack_addr) + stack_size) : 0;
+    }();
+    return stack_end;
+}
+
+/** Follows the chain of frame records {previous frame record, return address} starting at `fp`.
+ * Each record has to lie further up the stack than the previous one, so that a frame pointer register that was
+ * used for something else by code compiled without frame pointers truncates the trace, but never leads to a
+ * read outside of the stack.
+ */
+[[gnu::no_sanitize_address]]
+std::size_t walkFramePointers(void* const* fp, std::uintptr_t stack_end, std::size_t skip,
+                              void** out, std::size_t max_frames) noexcept
+{
+    std::size_t n = 0;
+    while (n < max_frames) {
+        auto const record = reinterpret_cast<std::uintptr_t>(fp);
+        if ((record % alignof(void*) != 0) || (record + 2 * sizeof(void*) > stack_end)) { break; }
+        void* const return_address = fp[1];
+        if (!return_address) { break; }
+        if (skip > 0) {
+            --skip;
+        } else {
+            out[n++] = return_address;
+        }
+        auto const next = static_cast<void* const*>(fp[0]);
+        if (reinterpret_cast<std::uintptr_t>(next) <= record) { break; }
+        fp = next;
+    }
+    return n;
+}
+#endif
+}
+
+Exception_Info::Records::stack_trace captureStackTrace(std::size_t skip_frames) noexcept
+{
+    using Exception_Info::Records::stack_trace;
+    stack_trace ret;
+    ret.size = 0;
+#if defined(GHULBUS_INTERNAL_HAS_FRAME_POINTER_WALK)
+    // the return address in the frame record of this function already belongs to the caller
+    ret.size = walkFramePointers(static_cast<void* const*>(__builtin_frame_address(0)), currentStackEnd(),
+                                 skip_frames, ret.frames, stack_trace::max_frames);
+#else
+    // skip the frame of this function
+    std::size_t const skip = skip_frames + 1;
+#   if defined(_WIN32)
+    if (skip < stack_trace::max_frames) {
+        ret.size = RtlCaptureStackBackTrace(static_cast<DWORD>(skip),
+                                            static_cast<DWORD>(stack_trace::max_frames - skip), ret.frames, nullptr);
+    }
+#   elif defined(GHULBUS_INTERNAL_HAS_EXECINFO)
+    int const captured = ::backtrace(ret.frames, static_cast<int>(stack_trace::max_frames));
+    if (captured > 0 && static_cast<std::size_t>(captured) > skip) {
+        ret.size = static_cast<std::size_t>(captured) - skip;
+        std::memmove(ret.frames, ret.frames + skip, ret.size * sizeof(void*));
+    }
+#   endif
+#endif
+    return ret;
+}
+
+void setStackTraceCaptureEnabled(bool enabled) noexcept
+{
+    g_stackTraceCaptureEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isStackTraceCaptureEnabled() noexcept
+{
+    return g_stackTraceCaptureEnabled.load(std::memory_order_relaxed);
+}
+
+namespace Exception_Info::Records
+{
+std::string to_string(stack_trace const& st)
+{
+    std::string ret;
+#if defined(GHULBUS_INTERNAL_HAS_EXECINFO)
+    // symbols are only resolved here, never at the throw site
+    char** const symbols = (st.size > 0) ? ::backtrace_symbols(st.frames, static_cast<int>(st.size)) : nullptr;
+#endif
+    for (std::size_t i = 0; i < st.size; ++i) {
+        char buffer[24];
+        ret.append("\n  #").append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), i).ptr).append(1, ' ');
+#if defined(GHULBUS_INTERNAL_HAS_EXECINFO)
+        if (symbols) {
+            ret.append(symbols[i]);
+            continue;
+        }
+#endif
+        auto const address = reinterpret_cast<std::uintptr_t>(st.frames[i]);
+        ret.append("0x").append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), address, 16).ptr);
+    }
+#if defined(GHULBUS_INTERNAL_HAS_EXECINFO)
+    std::free(symbols);
+#endif
+    return ret;
+}
+}
+
+namespace impl
+{
+namespace
+{
+/** Heap blocks of decorators are shared between copies of an exception.
+ * The reference count is stored in front of the first entry.
+ */
+struct SharedBlockHeader {
+    std::atomic<std::size_t> refcount;
+};
+
+constexpr std::size_t shared_block_alignment = alignof(std::max_align_t);
+constexpr std::size_t shared_block_header_size =
+    (sizeof(SharedBlockHeader) + shared_block_alignment - 1) / shared_block_alignment * shared_block_alignment;
+
+std::byte* allocateSharedBlock(std::size_t capacity)
+{
+    auto const p = static_cast<std::byte*>(::operator new(shared_block_header_size + capacity,
+                                                          std::align_val_t{ shared_block_alignment }));
+    ::new(p) SharedBlockHeader{ 1 };
+    return p + shared_block_header_size;
+}
+
+SharedBlockHeader& sharedBlockHeader(std::byte* block) noexcept
+{
+    return *std::launder(reinterpret_cast<SharedBlockHeader*>(block - shared_block_header_size));
+}
+
+void deallocateSharedBlock(std::byte* block) noexcept
+{
+    std::byte* const p = block - shared_block_header_size;
+    std::launder(reinterpret_cast<SharedBlockHeader*>(p))->~SharedBlockHeader();
+    ::operator delete(p, std::align_val_t{ shared_block_alignment });
+}
+}
+
+ErrorInfoStorage::~ErrorInfoStorage()
+{
+    clear();
+}
+
+ErrorInfoStorage::ErrorInfoStorage(ErrorInfoStorage const& rhs)
+{
+    copyFrom(rhs);
+}
+
+ErrorInfoStorage& ErrorInfoStorage::operator=(ErrorInfoStorage const& rhs)
+{
+    if (&rhs != this) {
+        ErrorInfoStorage tmp(rhs);
+        *this = std::move(tmp);
+    }
+    return *this;
+}
+
+ErrorInfoStorage::ErrorInfoStorage(ErrorInfoStorage&& rhs) noexcept
+{
+    moveFrom(rhs);
+}
+
+ErrorInfoStorage& ErrorInfoStorage::operator=(ErrorInfoStorage&& rhs) noexcept
+{
+    if (&rhs != this) {
+        clear();
+        moveFrom(rhs);
+    }
+    return *this;
+}
+
+bool ErrorInfoStorage::isShared() const noexcept
+{
+    return m_heap && (sharedBlockHeader(m_heap).refcount.load(std::memory_order_acquire) > 1);
+}
+
+void* ErrorInfoStorage::reserve(std::size_t entry_size)
+{
+    bool const is_shared = isShared();
+    if (is_shared || (m_size + entry_size > m_capacity)) {
+        std::size_t const new_capacity =
+            (m_size + entry_size > m_capacity) ? std::max(2 * m_capacity, m_size + entry_size) : m_capacity;
+        std::byte* const new_block = allocateSharedBlock(new_capacity);
+        std::byte* const old_block = data();
+        if (is_shared) {
+            // copy-on-write: the other owners keep the old block unchanged
+            std::size_t offset = 0;
+            try {
+                while (offset < m_size) {
+                    Header const& h = *std::launder(reinterpret_cast<Header const*>(old_block + offset));
+                    h.vtable->copy(new_block + offset + header_size, old_block + offset + header_size);
+                    ::new(new_block + offset) Header(h);
+                    offset += h.size;
+                }
+            } catch (...) {
+                for (std::size_t o = 0; o < offset;) {
+                    Header const& h = *std::launder(reinterpret_cast<Header const*>(new_block + o));
+                    h.vtable->destroy(new_block + o + header_size);
+                    o += h.size;
+                }
+                deallocateSharedBlock(new_block);
+                throw;
+            }
+            releaseHeap();
+        } else {
+            for (std::size_t offset = 0; offset < m_size;) {
+                Header const& h = *std::launder(reinterpret_cast<Header const*>(old_block + offset));
+                ::new(new_block + offset) Header(h);
+                h.vtable->relocate(new_block + offset + header_size, old_block + offset + header_size);
+                offset += h.size;
+            }
+            if (m_heap) { deallocateSharedBlock(m_heap); }
+        }
+        m_heap = new_block;
+        m_capacity = new_capacity;
+    }
+    return data() + m_size + header_size;
+}
+
+void ErrorInfoStorage::commit(VTable const* vtable, std::size_t entry_size) noexcept
+{
+    ::new(data() + m_size) Header{ vtable, entry_size };
+    addToIndex(vtable->id, m_size + header_size);
+    m_size += entry_size;
+}
+
+void ErrorInfoStorage::addToIndex(std::uint64_t id, std::size_t offset) noexcept
+{
+    if (m_indexOverflow) { return; }
+    IndexEntry* const last = m_index + m_indexSize;
+    IndexEntry* const it =
+        std::lower_bound(m_index, last, id, [](IndexEntry const& e, std::uint64_t i) { return e.id < i; });
+    if ((it != last) && (it->id == id)) {
+        it->offset = offset;
+    } else if (m_indexSize == index_capacity) {
+        m_indexOverflow = true;
+    } else {
+        std::move_backward(it, last, last + 1);
+        *it = IndexEntry{ id, offset };
+        ++m_indexSize;
+    }
+}
+
+void const* ErrorInfoStorage::find(std::uint64_t id, std::type_info const& tag,
+                                   std::type_info const& value) const noexcept
+{
+    auto const matches = [id, &tag, &value](VTable const& vtable) {
+        return (vtable.id == id) && (*vtable.tag == tag) && (*vtable.value == value);
+    };
+    if (!m_indexOverflow) {
+        IndexEntry const* const last = m_index + m_indexSize;
+        IndexEntry const* const it =
+            std::lower_bound(m_index, last, id, [](IndexEntry const& e, std::uint64_t i) { return e.id < i; });
+        if ((it == last) || (it->id != id)) { return nullptr; }
+        std::byte const* const p = data() + it->offset;
+        Header const& h = *std::launder(reinterpret_cast<Header const*>(p - header_size));
+        if (matches(*h.vtable)) { return p; }
+        // a different type with the same ID; fall back to a linear search
+    }
+    void const* ret = nullptr;
+    forEach([&matches, &ret](VTable const& vtable, void const* p) {
+        if (matches(vtable)) { ret = p; }
+    });
+    return ret;
+}
+
+void ErrorInfoStorage::releaseHeap() noexcept
+{
+    if (sharedBlockHeader(m_heap).refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        destroyEntries(m_heap);
+        deallocateSharedBlock(m_heap);
+    }
+    m_heap = nullptr;
+}
+
+void ErrorInfoStorage::destroyEntries(std::byte* base) noexcept
+{
+    for (std::size_t offset = 0; offset < m_size;) {
+        Header const& h = *std::launder(reinterpret_cast<Header const*>(base + offset));
+        h.vtable->destroy(base + offset + header_size);
+        offset += h.size;
+    }
+}
+
+void ErrorInfoStorage::clear() noexcept
+{
+    if (m_heap) {
+        releaseHeap();
+    } else {
+        destroyEntries(m_inline);
+    }
+    m_capacity = inline_capacity;
+    m_size = 0;
+    m_indexSize = 0;
+    m_indexOverflow = false;
+}
+
+void ErrorInfoStorage::copyFrom(ErrorInfoStorage const& rhs)
+{
+    if (rhs.m_heap) {
+        // entries are never modified once added, so heap blocks can be shared
+        sharedBlockHeader(rhs.m_heap).refcount.fetch_add(1, std::memory_order_relaxed);
+        m_heap = rhs.m_heap;
+        m_capacity = rhs.m_capacity;
+        m_size = rhs.m_size;
+    } else {
+        try {
+            for (std::size_t offset = 0; offset < rhs.m_size;) {
+                Header const& h = *std::launder(reinterpret_cast<Header const*>(rhs.m_inline + offset));
+                h.vtable->copy(m_inline + offset + header_size, rhs.m_inline + offset + header_size);
+                ::new(m_inline + offset) Header(h);
+                offset += h.size;
+                m_size = offset;
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    std::copy(rhs.m_index, rhs.m_index + rhs.m_indexSize, m_index);
+    m_indexSize = rhs.m_indexSize;
+    m_indexOverflow = rhs.m_indexOverflow;
+}
+
+void ErrorInfoStorage::moveFrom(ErrorInfoStorage& rhs) noexcept
+{
+    if (rhs.m_heap) {
+        m_heap = std::exchange(rhs.m_heap, nullptr);
+        m_capacity = std::exchange(rhs.m_capacity, inline_capacity);
+        m_size = std::exchange(rhs.m_size, 0);
+    } else {
+        for (std::size_t offset = 0; offset < rhs.m_size;) {
+            Header const& h = *std::launder(reinterpret_cast<Header const*>(rhs.m_inline + offset));
+            ::new(m_inline + offset) Header(h);
+            h.vtable->relocate(m_inline + offset + header_size, rhs.m_inline + offset + header_size);
+            offset += h.size;
+        }
+        m_size = std::exchange(rhs.m_size, 0);
+    }
+    std::copy(rhs.m_index, rhs.m_index + rhs.m_indexSize, m_index);
+    m_indexSize = std::exchange(rhs.m_indexSize, 0);
+    m_indexOverflow = std::exchange(rhs.m_indexOverflow, false);
+}
+}
+
+void Exception::buildDiagnosticMessage() const
+{
+    /*
+    <file>(<line>): Throw in function <func>
+    Dynamic exception type: <type>
+    <description>
+    [<TagType #1>] = <data #1>
+     ...
+    [<TagType #n>] = <data #n>
+    */
+    char const* const file = m_location.file ? m_location.file : "<unknown file>";
+    char const* const function = m_location.function ? m_location.function : "<unknown function>";
+    char const* const type_name = typeid(*this).name();
+    std::string_view const description = getDescriptionView();
+    char line[24];
+    char* const line_end = std::to_chars(line, line + sizeof(line), m_location.line).ptr;
+
+    std::size_t decorators_size = 0;
+    m_errorInfos.forEach([&decorators_size](impl::ErrorInfoStorage::VTable const& vtable, void const* data) {
+        decorators_size += std::strlen(vtable.tag->name()) + 6 + vtable.dataStringSizeHint(data);
+    });
+
+    std::string& msg = m_diagnosticMessageCached;
+    msg.clear();
+    msg.reserve(std::strlen(file) + (line_end - line) + std::strlen(function) + std::strlen(type_name) +
+                description.size() + 48 + decorators_size);
+    msg.append(file).append(1, '(').append(line, line_end).append("): Throw in function ").append(function);
+    msg.append("\nDynamic exception type: ").append(type_name);
+    msg.append(1, '\n').append(description);
+    m_errorInfos.forEach([&msg](impl::ErrorInfoStorage::VTable const& vtable, void const* data) {
+        msg.append("\n[").append(vtable.tag->name()).append("] = ");
+        vtable.appendDataString(data, msg);
+    });
+}
+}
@@ -0,0 +1,50 @@
+#include <gbBase/ExceptionTelemetry.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+namespace
+{
+/// Head of the intrusive list of all registered sites; sites are only ever prepended.
+std::atomic<ThrowSite*> g_throwSites{ nullptr };
+std::chrono::steady_clock::time_point const g_startTime = std::chrono::steady_clock::now();
+}
+
+ThrowSite::ThrowSite(char const* file, char const* function, long line, std::type_info const& exception_type) noexcept
+    :m_file(file), m_function(function), m_line(line), m_exceptionType(&exception_type), m_count(0),
+     m_next(g_throwSites.load(std::memory_order_relaxed))
+{
+    while (!g_throwSites.compare_exchange_weak(m_next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+ThrowSiteSnapshot ThrowSiteSnapshot::take(ThrowSiteSnapshot const* previous)
+{
+    ThrowSiteSnapshot ret;
+    ret.timestamp = std::chrono::steady_clock::now();
+    ret.interval = ret.timestamp - (previous ? previous->timestamp : g_startTime);
+    for (ThrowSite const* s = g_throwSites.load(std::memory_order_acquire); s; s = s->m_next) {
+        std::uint64_t const count = s->m_count.load(std::memory_order_relaxed);
+        ret.sites.push_back(Site{ s, s->m_file, s->m_function, s->m_line, s->m_exceptionType, count, count });
+    }
+    if (previous) {
+        std::vector<std::pair<ThrowSite const*, std::uint64_t>> previous_counts;
+        previous_counts.reserve(previous->sites.size());
+        for (Site const& p : previous->sites) { previous_counts.emplace_back(p.site, p.count); }
+        auto const by_site = [](auto const& lhs, auto const& rhs) {
+            return std::less<ThrowSite const*>{}(lhs.first, rhs.first);
+        };
+        std::sort(previous_counts.begin(), previous_counts.end(), by_site);
+        for (Site& site : ret.sites) {
+            auto const it = std::lower_bound(previous_counts.begin(), previous_counts.end(), std::pair(site.site, 0),
+                                             by_site);
+            if ((it != previous_counts.end()) && (it->first == site.site)) { site.delta -= it->second; }
+        }
+    }
+    std::stable_sort(ret.sites.begin(), ret.sites.end(),
+                     [](Site const& lhs, Site const& rhs) { return lhs.delta > rhs.delta; });
+    return ret;
+}
+}
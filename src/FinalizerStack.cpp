@@ -0,0 +1,68 @@
+#include <gbBase/FinalizerStack.hpp>
+
+#include <gbBase/Assert.hpp>
+
+#include <cstdint>
+#include <exception>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+FinalizerStack::FinalizerStack(UnwindPolicy policy, std::size_t chunk_size)
+    :m_chunkSize(chunk_size), m_policy(policy), m_uncaughtExceptions(std::uncaught_exceptions())
+{
+    GHULBUS_PRECONDITION(chunk_size > 0);
+}
+
+FinalizerStack::~FinalizerStack()
+{
+    bool const invoke = (m_policy == UnwindPolicy::Always) ||
+                        (std::uncaught_exceptions() > m_uncaughtExceptions);
+    popAll(invoke);
+}
+
+void FinalizerStack::unwind() noexcept
+{
+    popAll(true);
+}
+
+void FinalizerStack::defuse() noexcept
+{
+    popAll(false);
+}
+
+void FinalizerStack::popAll(bool invoke) noexcept
+{
+    // actions may push new actions while being executed, so we pop them one at a time
+    while (m_top) {
+        Entry* const e = m_top;
+        m_top = e->previous;
+        --m_size;
+        e->finalize(e, invoke);
+    }
+    m_currentChunk = 0;
+    m_chunkOffset = 0;
+}
+
+void* FinalizerStack::allocate(std::size_t size, std::size_t alignment)
+{
+    for (;;) {
+        if (m_currentChunk < m_chunks.size()) {
+            Chunk& chunk = m_chunks[m_currentChunk];
+            std::uintptr_t const base = reinterpret_cast<std::uintptr_t>(chunk.memory.get());
+            std::size_t const offset =
+                static_cast<std::size_t>(((base + m_chunkOffset + alignment - 1) & ~(alignment - 1)) - base);
+            if (offset + size <= chunk.size) {
+                m_chunkOffset = offset + size;
+                return chunk.memory.get() + offset;
+            }
+            ++m_currentChunk;
+            m_chunkOffset = 0;
+        } else {
+            // chunks grow geometrically to keep the number of allocations logarithmic in the total size
+            std::size_t const chunk_size =
+                std::max(m_chunks.empty() ? m_chunkSize : 2 * m_chunks.back().size, size + alignment - 1);
+            m_chunks.push_back(Chunk{ std::make_unique_for_overwrite<std::byte[]>(chunk_size), chunk_size });
+        }
+    }
+}
+}
@@ -0,0 +1,73 @@
+#include <gbBase/Task.hpp>
+
+#include <array>
+#include <new>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+namespace
+{
+constexpr std::size_t frame_granularity = 64;
+constexpr std::size_t n_size_classes = 16;          ///< frames up to 1 KiB are recycled
+constexpr std::size_t max_cached_frames = 64;       ///< per size class and thread
+
+struct FreeFrame {
+    FreeFrame* next;
+};
+
+/** Thread-local cache of freed coroutine frames.
+ */
+struct FrameCache {
+    std::array<FreeFrame*, n_size_classes> freeLists{};
+    std::array<std::size_t, n_size_classes> counts{};
+    bool isAlive = true;
+
+    ~FrameCache()
+    {
+        for (FreeFrame* head : freeLists) {
+            while (head) {
+                FreeFrame* const next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+        // frames freed during destruction of other thread-local objects bypass the cache
+        isAlive = false;
+    }
+};
+
+thread_local FrameCache t_frameCache;
+
+std::size_t sizeClass(std::size_t size) noexcept
+{
+    return (size + frame_granularity - 1) / frame_granularity - 1;
+}
+}
+
+namespace impl {
+void* allocateCoroutineFrame(std::size_t size)
+{
+    std::size_t const size_class = sizeClass(size);
+    if (size_class >= n_size_classes) { return ::operator new(size); }
+    FrameCache& cache = t_frameCache;
+    if (FreeFrame* const frame = cache.freeLists[size_class]; frame && cache.isAlive) {
+        cache.freeLists[size_class] = frame->next;
+        --cache.counts[size_class];
+        return frame;
+    }
+    return ::operator new((size_class + 1) * frame_granularity);
+}
+
+void deallocateCoroutineFrame(void* p, std::size_t size) noexcept
+{
+    std::size_t const size_class = sizeClass(size);
+    FrameCache& cache = t_frameCache;
+    if ((size_class >= n_size_classes) || !cache.isAlive || (cache.counts[size_class] >= max_cached_frames)) {
+        ::operator delete(p);
+        return;
+    }
+    cache.freeLists[size_class] = ::new(p) FreeFrame{ cache.freeLists[size_class] };
+    ++cache.counts[size_class];
+}
+}
+}
@@ -0,0 +1,390 @@
+#include <gbBase/ThreadPool.hpp>
+
+#include <cstdint>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+namespace
+{
+thread_local ThreadPool const* t_currentPool = nullptr;
+thread_local std::size_t t_workerIndex = 0;
+
+class TaskNodePool;
+
+struct TaskNode {
+    ThreadPool::Task task;
+    TaskNode* next = nullptr;
+    TaskNodePool* pool = nullptr;
+};
+
+/** Recycled storage for the tasks in a worker's deque.
+ * Only the owning worker acquires nodes from the pool. Nodes are given back by whichever worker ran the task:
+ * the owner puts them directly on its free list, while other workers push them to a lock-free stack that the
+ * owner takes over as a whole once its free list runs dry. Nodes are only freed when the pool is destroyed.
+ */
+class TaskNodePool {
+private:
+    static constexpr std::size_t chunk_size = 64;
+
+    TaskNode* m_free = nullptr;                             ///< Owner-only.
+    std::vector<std::unique_ptr<TaskNode[]>> m_chunks;      ///< Owner-only.
+    alignas(64) std::atomic<TaskNode*> m_returned;
+public:
+    TaskNodePool()
+        :m_returned(nullptr)
+    {}
+
+    TaskNodePool(TaskNodePool const&) = delete;
+    TaskNodePool& operator=(TaskNodePool const&) = delete;
+
+    /** \pre Must only be called by the owning worker.
+     */
+    TaskNode* acquire()
+    {
+        if (!m_free) {
+            m_free = m_returned.exchange(nullptr, std::memory_order_acquire);
+            if (!m_free) { allocateChunk(); }
+        }
+        TaskNode* ret = m_free;
+        m_free = ret->next;
+        return ret;
+    }
+
+    /** \pre Must only be called by the owning worker.
+     */
+    void release(TaskNode* node) noexcept
+    {
+        node->next = m_free;
+        m_free = node;
+    }
+
+    void releaseRemote(TaskNode* node) noexcept
+    {
+        node->next = m_returned.load(std::memory_order_relaxed);
+        while (!m_returned.compare_exchange_weak(node->next, node,
+                                                 std::memory_order_release, std::memory_order_relaxed))
+        {}
+    }
+private:
+    void allocateChunk()
+    {
+        m_chunks.push_back(std::make_unique<TaskNode[]>(chunk_size));
+        TaskNode* const chunk = m_chunks.back().get();
+        for (std::size_t i = 0; i < chunk_size; ++i) {
+            chunk[i].next = (i + 1 < chunk_size) ? &chunk[i + 1] : nullptr;
+            chunk[i].pool = this;
+        }
+        m_free = chunk;
+    }
+};
+
+/** Chase-Lev work-stealing deque.
+ * The memory orderings follow Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models", except
+ * that tasks are published by release stores to m_bottom instead of a release fence.
+ * Only the owning worker may push() and take(), which operate on the bottom end of the deque.
+ * Any thread may steal() from the top end.
+ */
+class WorkStealingDeque {
+private:
+    struct Array {
+        std::int64_t capacity;
+        std::unique_ptr<std::atomic<TaskNode*>[]> slots;
+
+        explicit Array(std::int64_t n_capacity)
+            :capacity(n_capacity),
+             slots(std::make_unique<std::atomic<TaskNode*>[]>(static_cast<std::size_t>(n_capacity)))
+        {}
+
+        TaskNode* get(std::int64_t i) const noexcept
+        {
+            return slots[static_cast<std::size_t>(i & (capacity - 1))].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t i, TaskNode* t) noexcept
+        {
+            slots[static_cast<std::size_t>(i & (capacity - 1))].store(t, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<std::int64_t> m_top;
+    alignas(64) std::atomic<std::int64_t> m_bottom;
+    std::atomic<Array*> m_array;
+    /// Owner-only. Arrays replaced by a larger one are kept alive, as thieves might still be reading from them.
+    std::vector<std::unique_ptr<Array>> m_arrays;
+public:
+    WorkStealingDeque()
+        :m_top(0), m_bottom(0)
+    {
+        m_arrays.push_back(std::make_unique<Array>(256));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(WorkStealingDeque const&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+
+    void push(TaskNode* t)
+    {
+        std::int64_t const b = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t const top = m_top.load(std::memory_order_acquire);
+        Array* a = m_array.load(std::memory_order_relaxed);
+        if (b - top > a->capacity - 1) {
+            a = grow(a, top, b);
+        }
+        a->put(b, t);
+        m_bottom.store(b + 1, std::memory_order_release);
+    }
+
+    TaskNode* take() noexcept
+    {
+        std::int64_t const b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+        if (top > b) {
+            m_bottom.store(b + 1, std::memory_order_release);
+            return nullptr;
+        }
+        TaskNode* ret = a->get(b);
+        if (top == b) {
+            // last element; race against thieves
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                ret = nullptr;
+            }
+            m_bottom.store(b + 1, std::memory_order_release);
+        }
+        return ret;
+    }
+
+    /** @return The stolen task or nullptr if the deque was empty or another thread won the race.
+     */
+    TaskNode* steal() noexcept
+    {
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t const b = m_bottom.load(std::memory_order_acquire);
+        if (top >= b) { return nullptr; }
+        Array* a = m_array.load(std::memory_order_acquire);
+        TaskNode* ret = a->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return ret;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+private:
+    Array* grow(Array* a, std::int64_t top, std::int64_t bottom)
+    {
+        auto new_array = std::make_unique<Array>(a->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i) {
+            new_array->put(i, a->get(i));
+        }
+        m_arrays.push_back(std::move(new_array));
+        Array* ret = m_arrays.back().get();
+        m_array.store(ret, std::memory_order_release);
+        return ret;
+    }
+};
+
+std::uint64_t nextRandom(std::uint64_t& state) noexcept
+{
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void runTask(ThreadPool::Task& task) noexcept
+{
+    task();
+}
+
+/** Runs the task of a node and gives the node back to its pool.
+ */
+void runTask(TaskNode* node, TaskNodePool& self) noexcept
+{
+    runTask(node->task);
+    node->task = nullptr;
+    if (node->pool == &self) {
+        self.release(node);
+    } else {
+        node->pool->releaseRemote(node);
+    }
+}
+}
+
+struct ThreadPool::Worker {
+    WorkStealingDeque deque;
+    TaskNodePool pool;
+    std::uint64_t rng;
+};
+
+ThreadPool::ThreadPool()
+    :ThreadPool(std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+{}
+
+ThreadPool::ThreadPool(std::size_t n_threads)
+    :m_workers(std::make_unique<Worker[]>(n_threads)), m_nWorkers(n_threads),
+     m_injectionQueue(injection_queue_capacity), m_wakeSignal(0), m_sleeping(0), m_stop(false)
+{
+    GHULBUS_PRECONDITION(n_threads > 0);
+    for (std::size_t i = 0; i < n_threads; ++i) {
+        m_workers[i].rng = 0x9e3779b97f4a7c15ull * (i + 1);
+    }
+    m_threads.reserve(n_threads);
+    try {
+        for (std::size_t i = 0; i < n_threads; ++i) {
+            m_threads.emplace_back([this, i]() { workerMain(i); });
+        }
+    } catch (...) {
+        m_stop.store(true, std::memory_order_seq_cst);
+        wakeWorkers(n_threads);
+        for (auto& t : m_threads) { t.join(); }
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    m_stop.store(true, std::memory_order_seq_cst);
+    m_wakeSignal.fetch_add(1, std::memory_order_release);
+    m_wakeSignal.notify_all();
+    for (auto& t : m_threads) { t.join(); }
+}
+
+bool ThreadPool::isWorkerThread() const noexcept
+{
+    return t_currentPool == this;
+}
+
+void ThreadPool::post(Task task)
+{
+    GHULBUS_PRECONDITION(!task.empty());
+    if (isWorkerThread()) {
+        pushLocal(task);
+    } else {
+        inject(task);
+    }
+    wakeWorkers(1);
+}
+
+void ThreadPool::post(std::span<Task> tasks)
+{
+    if (tasks.empty()) { return; }
+    for (auto const& task : tasks) { GHULBUS_PRECONDITION(!task.empty()); }
+    if (isWorkerThread()) {
+        for (auto& task : tasks) { pushLocal(task); }
+    } else {
+        for (auto& task : tasks) { inject(task); }
+    }
+    wakeWorkers(tasks.size());
+}
+
+void ThreadPool::pushLocal(Task& task)
+{
+    Worker& self = m_workers[t_workerIndex];
+    TaskNode* node = self.pool.acquire();
+    node->task = std::move(task);
+    try {
+        self.deque.push(node);
+    } catch (...) {
+        task = std::move(node->task);
+        self.pool.release(node);
+        throw;
+    }
+}
+
+void ThreadPool::inject(Task& task)
+{
+    if (!m_injectionQueue.try_push(std::move(task))) {
+        // the workers may not have been woken up for the tasks that filled the queue yet
+        wakeWorkers(m_nWorkers);
+        m_injectionQueue.push(std::move(task));
+    }
+}
+
+void ThreadPool::waitFor(impl::TaskStateBase& state)
+{
+    if (isWorkerThread()) {
+        // help out with other tasks while waiting
+        while (!state.isReady() && tryRunTask(t_workerIndex)) {}
+    }
+    state.wait();
+}
+
+bool ThreadPool::tryRunTask(std::size_t worker_index)
+{
+    Worker& self = m_workers[worker_index];
+    if (TaskNode* node = self.deque.take()) {
+        runTask(node, self.pool);
+        return true;
+    }
+    if (auto task = m_injectionQueue.try_pop()) {
+        runTask(*task);
+        return true;
+    }
+    std::size_t const start = static_cast<std::size_t>(nextRandom(self.rng) % m_nWorkers);
+    for (std::size_t i = 0; i < m_nWorkers; ++i) {
+        std::size_t const victim = (start + i) % m_nWorkers;
+        if (victim == worker_index) { continue; }
+        if (TaskNode* node = m_workers[victim].deque.steal()) {
+            runTask(node, self.pool);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerMain(std::size_t worker_index)
+{
+    t_currentPool = this;
+    t_workerIndex = worker_index;
+    for (;;) {
+        if (tryRunTask(worker_index)) { continue; }
+        // The fence pairs with the one in wakeWorkers(): Either we see the newly submitted work,
+        // or the submitting thread sees that we are sleeping and notifies.
+        m_sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint32_t const signal = m_wakeSignal.load(std::memory_order_acquire);
+        if (hasWork()) {
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (m_stop.load(std::memory_order_acquire)) {
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        m_wakeSignal.wait(signal, std::memory_order_acquire);
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+    t_currentPool = nullptr;
+}
+
+void ThreadPool::wakeWorkers(std::size_t n)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::uint32_t const sleeping = m_sleeping.load(std::memory_order_relaxed);
+    if (sleeping > 0) {
+        m_wakeSignal.fetch_add(1, std::memory_order_release);
+        if (n >= sleeping) {
+            m_wakeSignal.notify_all();
+        } else {
+            for (std::size_t i = 0; i < n; ++i) { m_wakeSignal.notify_one(); }
+        }
+    }
+}
+
+bool ThreadPool::hasWork() const noexcept
+{
+    if (!m_injectionQueue.empty()) { return true; }
+    for (std::size_t i = 0; i < m_nWorkers; ++i) {
+        if (!m_workers[i].deque.empty()) { return true; }
+    }
+    return false;
+}
+}
@@ -0,0 +1,212 @@
+#include <gbBase/TimerWheel.hpp>
+#include <gbBase/Assert.hpp>
+#include <gbBase/Finally.hpp>
+
+#include <utility>
+
+namespace GHULBUS_BASE_NAMESPACE
+{
+TimerWheel::TimerWheel()
+    :TimerWheel(0)
+{}
+
+TimerWheel::TimerWheel(Tick now)
+    :m_freeList(invalid_index), m_now(now), m_size(0)
+{
+    m_heads.fill(invalid_index);
+}
+
+TimerWheel::~TimerWheel() = default;
+
+TimerWheel::TimerId TimerWheel::schedule(Tick delay, Callback callback)
+{
+    GHULBUS_PRECONDITION(!callback.empty());
+    std::uint32_t const index = allocateNode();
+    Node& node = m_nodes[index];
+    // the timer fires during the tick() that advances the wheel to m_now + delay
+    node.expires = m_now + ((delay == 0) ? 0 : (delay - 1));
+    node.period = 0;
+    node.callback = std::move(callback);
+    insert(index);
+    ++m_size;
+    return TimerId{ index, node.generation };
+}
+
+TimerWheel::TimerId TimerWheel::schedulePeriodic(Tick period, Callback callback)
+{
+    GHULBUS_PRECONDITION(period > 0);
+    TimerId const ret = schedule(period, std::move(callback));
+    m_nodes[ret.index].period = period;
+    return ret;
+}
+
+bool TimerWheel::cancel(TimerId id)
+{
+    if ((id.index >= m_nodes.size()) || (m_nodes[id.index].generation != id.generation) ||
+        (m_nodes[id.index].bucket == free_bucket))
+    {
+        return false;
+    }
+    if (m_nodes[id.index].bucket != running_bucket) {
+        unlink(id.index);
+    }
+    m_nodes[id.index].callback = Callback{};
+    freeNode(id.index);
+    --m_size;
+    return true;
+}
+
+std::size_t TimerWheel::tick()
+{
+    // finish callbacks left over from a previous tick that was interrupted by an exception
+    std::size_t n_invoked = runPending();
+
+    std::size_t const root_slot = static_cast<std::size_t>(m_now & (root_size - 1));
+    if (root_slot == 0) {
+        for (int level = 0; level < n_levels; ++level) {
+            std::size_t const slot = static_cast<std::size_t>((m_now >> (root_bits + level * level_bits)) &
+                                                              (level_size - 1));
+            cascade(level, slot);
+            if (slot != 0) { break; }
+        }
+    }
+
+    // move all expired timers to the pending list, so that callbacks are free to cancel them
+    for (std::uint32_t it = m_heads[root_slot]; it != invalid_index;) {
+        std::uint32_t const next = m_nodes[it].next;
+        unlink(it);
+        link(it, pending_bucket);
+        it = next;
+    }
+    ++m_now;
+    n_invoked += runPending();
+    return n_invoked;
+}
+
+std::size_t TimerWheel::advance(Tick ticks)
+{
+    std::size_t n_invoked = 0;
+    for (Tick i = 0; i < ticks; ++i) {
+        n_invoked += tick();
+    }
+    return n_invoked;
+}
+
+void TimerWheel::reserve(std::size_t n_timers)
+{
+    m_nodes.reserve(n_timers);
+}
+
+std::uint32_t TimerWheel::allocateNode()
+{
+    if (m_freeList != invalid_index) {
+        std::uint32_t const index = m_freeList;
+        m_freeList = m_nodes[index].next;
+        return index;
+    }
+    GHULBUS_ASSERT(m_nodes.size() < invalid_index);
+    m_nodes.push_back(Node{ 0, 0, invalid_index, invalid_index, free_bucket, 0, Callback{} });
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
+
+void TimerWheel::freeNode(std::uint32_t index) noexcept
+{
+    Node& node = m_nodes[index];
+    ++node.generation;
+    node.bucket = free_bucket;
+    node.prev = invalid_index;
+    node.next = m_freeList;
+    m_freeList = index;
+}
+
+void TimerWheel::link(std::uint32_t index, std::uint32_t bucket) noexcept
+{
+    Node& node = m_nodes[index];
+    node.bucket = bucket;
+    node.prev = invalid_index;
+    node.next = m_heads[bucket];
+    if (node.next != invalid_index) { m_nodes[node.next].prev = index; }
+    m_heads[bucket] = index;
+}
+
+void TimerWheel::unlink(std::uint32_t index) noexcept
+{
+    Node& node = m_nodes[index];
+    if (node.prev != invalid_index) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_heads[node.bucket] = node.next;
+    }
+    if (node.next != invalid_index) { m_nodes[node.next].prev = node.prev; }
+}
+
+void TimerWheel::insert(std::uint32_t index) noexcept
+{
+    Tick expires = m_nodes[index].expires;
+    Tick const diff = expires - m_now;
+    std::uint32_t bucket;
+    if (expires < m_now) {
+        // already expired; fire on the next tick
+        bucket = static_cast<std::uint32_t>(m_now & (root_size - 1));
+    } else if (diff < root_size) {
+        bucket = static_cast<std::uint32_t>(expires & (root_size - 1));
+    } else {
+        int level = 0;
+        while ((level < n_levels - 1) && (diff >= (Tick(1) << (root_bits + (level + 1) * level_bits)))) {
+            ++level;
+        }
+        if (level == n_levels - 1) {
+            // timers beyond the range of the wheel are parked at its far end and cascaded down repeatedly
+            Tick const max_diff = (Tick(1) << (root_bits + n_levels * level_bits)) - 1;
+            if (diff > max_diff) { expires = m_now + max_diff; }
+        }
+        std::size_t const slot = static_cast<std::size_t>((expires >> (root_bits + level * level_bits)) &
+                                                          (level_size - 1));
+        bucket = static_cast<std::uint32_t>(root_size + level * level_size + slot);
+    }
+    link(index, bucket);
+}
+
+void TimerWheel::cascade(int level, std::size_t slot) noexcept
+{
+    std::uint32_t const bucket = static_cast<std::uint32_t>(root_size + level * level_size + slot);
+    std::uint32_t it = m_heads[bucket];
+    m_heads[bucket] = invalid_index;
+    while (it != invalid_index) {
+        std::uint32_t const next = m_nodes[it].next;
+        insert(it);
+        it = next;
+    }
+}
+
+std::size_t TimerWheel::runPending()
+{
+    std::size_t n_invoked = 0;
+    while (m_heads[pending_bucket] != invalid_index) {
+        std::uint32_t const index = m_heads[pending_bucket];
+        unlink(index);
+        Callback callback = std::move(m_nodes[index].callback);
+        std::uint32_t const generation = m_nodes[index].generation;
+        if (m_nodes[index].period == 0) {
+            freeNode(index);
+            --m_size;
+            ++n_invoked;
+            callback();
+        } else {
+            m_nodes[index].bucket = running_bucket;
+            ++n_invoked;
+            auto const reschedule = finally([this, index, generation, &callback]() {
+                // the callback may have cancelled the timer or caused m_nodes to reallocate
+                Node& node = m_nodes[index];
+                if (node.generation == generation) {
+                    node.callback = std::move(callback);
+                    node.expires += node.period;
+                    insert(index);
+                }
+            });
+            callback();
+        }
+    }
+    return n_invoked;
+}
+}
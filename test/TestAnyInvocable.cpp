@@ -1,8 +1,15 @@
 #include <gbBase/AnyInvocable.hpp>
+#include <gbBase/Assert.hpp>
 
 #include <catch.hpp>
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
 
 namespace {
 int free_function() {
@@ -42,6 +49,89 @@ struct CountCopies {
     CountCopies(CountCopies&&) = default;
     CountCopies& operator=(CountCopies&&) = default;
 };
+
+struct alignas(64) OverAligned {
+    int i = 42;
+
+    std::uintptr_t operator()() const {
+        return reinterpret_cast<std::uintptr_t>(this);
+    }
+};
+
+struct ThrowingMove {
+    static inline int instances = 0;
+    bool throw_on_copy = false;
+
+    ThrowingMove() { ++instances; }
+    ThrowingMove(ThrowingMove const& rhs) : throw_on_copy(rhs.throw_on_copy) {
+        if (throw_on_copy) { throw std::runtime_error("copy"); }
+        ++instances;
+    }
+    ThrowingMove(ThrowingMove&& rhs) : throw_on_copy(rhs.throw_on_copy) { ++instances; }
+    ~ThrowingMove() { --instances; }
+
+    int operator()() const {
+        return 42;
+    }
+};
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+    int deallocations = 0;
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& rhs) const noexcept override {
+        return this == &rhs;
+    }
+};
+
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+    int* allocations;
+
+    explicit CountingAllocator(int* n_allocations) noexcept : allocations(n_allocations) {}
+    template<typename U>
+    CountingAllocator(CountingAllocator<U> const& rhs) noexcept : allocations(rhs.allocations) {}
+
+    T* allocate(std::size_t n) {
+        ++(*allocations);
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        --(*allocations);
+        std::allocator<T>{}.deallocate(p, n);
+    }
+};
+
+struct Qualified {
+    int operator()() & { return 1; }
+    int operator()() && { return 2; }
+    int operator()() const& { return 3; }
+    int operator()() const&& { return 4; }
+};
+
+struct ConstructorArgs {
+    int a;
+    std::unique_ptr<int> b;
+
+    ConstructorArgs(int na, std::unique_ptr<int> nb)
+        :a(na), b(std::move(nb))
+    {}
+
+    int operator()() const { return a + *b; }
+};
 }
 
 TEST_CASE("AnyInvocable")
@@ -145,4 +235,306 @@ TEST_CASE("AnyInvocable")
         static_assert(std::is_nothrow_move_constructible_v<decltype(func)>,
                       "Noexcept on move constructor is missing.");
     }
+
+    SECTION("Small callables are stored inline")
+    {
+        int i = 42;
+        auto small = [&i]() { return i; };
+        auto big = [a = std::uintptr_t(0), b = std::uintptr_t(0), c = std::uintptr_t(0), d = std::uintptr_t(0)]() {
+            return a + b + c + d;
+        };
+        CHECK(AnyInvocable<int()>::storesInline<decltype(small)>());
+        CHECK(AnyInvocable<int()>::storesInline<int(*)()>());
+        CHECK(!AnyInvocable<int()>::storesInline<decltype(big)>());
+        CHECK(!AnyInvocable<std::uintptr_t()>::storesInline<OverAligned>());
+        CHECK(!AnyInvocable<int()>::storesInline<ThrowingMove>());
+    }
+
+    SECTION("Trivially copyable callables")
+    {
+        auto func = [a = 1, b = 2, c = 3]() { return a + b + c; };
+        static_assert(std::is_trivially_copyable_v<decltype(func)>);
+        AnyInvocable<int()> func1(func);
+        AnyInvocable<int()> func2(std::move(func1));
+        CHECK(func1.empty());
+        CHECK(func2() == 6);
+        func1 = std::move(func2);
+        CHECK(func1() == 6);
+    }
+
+    SECTION("Mutable state is preserved across moves")
+    {
+        AnyInvocable<int()> func1([i = 0]() mutable { return ++i; });
+        CHECK(func1() == 1);
+        AnyInvocable<int()> func2(std::move(func1));
+        CHECK(func2() == 2);
+        AnyInvocable<int()> func3([p = std::make_unique<int>(0)]() { return ++(*p); });
+        CHECK(func3() == 1);
+        AnyInvocable<int()> func4(std::move(func3));
+        CHECK(func4() == 2);
+    }
+
+    SECTION("Inline callables survive moves")
+    {
+        auto p = std::make_shared<int>(42);
+        AnyInvocable<int()> func1([p]() { return *p; });
+        CHECK(p.use_count() == 2);
+        AnyInvocable<int()> func2(std::move(func1));
+        CHECK(func1.empty());
+        CHECK(p.use_count() == 2);
+        CHECK(func2() == 42);
+        AnyInvocable<int()> func3;
+        func3 = std::move(func2);
+        CHECK(p.use_count() == 2);
+        CHECK(func3() == 42);
+        func3 = AnyInvocable<int()>{};
+        CHECK(p.use_count() == 1);
+    }
+
+    SECTION("Over-aligned callables")
+    {
+        AnyInvocable<std::uintptr_t()> func1(OverAligned{});
+        CHECK(func1() % alignof(OverAligned) == 0);
+        AnyInvocable<std::uintptr_t()> func2(std::move(func1));
+        CHECK(func2() % alignof(OverAligned) == 0);
+    }
+
+    SECTION("Callables with throwing move")
+    {
+        {
+            AnyInvocable<int()> func1(ThrowingMove{});
+            CHECK(ThrowingMove::instances == 1);
+            AnyInvocable<int()> func2(std::move(func1));
+            CHECK(ThrowingMove::instances == 1);
+            CHECK(func2() == 42);
+        }
+        CHECK(ThrowingMove::instances == 0);
+    }
+
+    SECTION("Exception during construction")
+    {
+        {
+            ThrowingMove tm;
+            tm.throw_on_copy = true;
+            CHECK_THROWS_AS(AnyInvocable<int()>(tm), std::runtime_error);
+            CHECK(ThrowingMove::instances == 1);
+        }
+        CHECK(ThrowingMove::instances == 0);
+    }
+}
+
+TEST_CASE("AnyInvocable Qualifiers")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Unqualified signature invokes as non-const lvalue")
+    {
+        AnyInvocable<int()> func(Qualified{});
+        CHECK(func() == 1);
+        CHECK(std::move(func)() == 1);
+        static_assert(!std::is_invocable_v<AnyInvocable<int()> const&>);
+    }
+
+    SECTION("Const signature")
+    {
+        AnyInvocable<int() const> const func(Qualified{});
+        CHECK(func() == 3);
+        static_assert(std::is_invocable_v<AnyInvocable<int() const> const&>);
+        static_assert(!std::is_constructible_v<AnyInvocable<int() const>, MoveOnly>);
+    }
+
+    SECTION("Ref-qualified signatures")
+    {
+        AnyInvocable<int() &> func_lref(Qualified{});
+        CHECK(func_lref() == 1);
+        static_assert(!std::is_invocable_v<AnyInvocable<int() &>&&>);
+
+        AnyInvocable<int() &&> func_rref(Qualified{});
+        CHECK(std::move(func_rref)() == 2);
+        static_assert(!std::is_invocable_v<AnyInvocable<int() &&>&>);
+
+        AnyInvocable<int() const&> const func_clref(Qualified{});
+        CHECK(func_clref() == 3);
+
+        AnyInvocable<int() const&&> const func_crref(Qualified{});
+        CHECK(std::move(func_crref)() == 4);
+    }
+
+    SECTION("Noexcept signature")
+    {
+        auto throwing = []() { return 42; };
+        auto nonthrowing = []() noexcept { return 42; };
+        static_assert(!std::is_constructible_v<AnyInvocable<int() noexcept>, decltype(throwing)>);
+        static_assert(std::is_constructible_v<AnyInvocable<int() noexcept>, decltype(nonthrowing)>);
+        static_assert(std::is_constructible_v<AnyInvocable<int()>, decltype(nonthrowing)>);
+        AnyInvocable<int() const noexcept> func(nonthrowing);
+        static_assert(noexcept(func()));
+        static_assert(!noexcept(std::declval<AnyInvocable<int()>&>()()));
+        CHECK(func() == 42);
+    }
+
+    SECTION("Operator bool and nullptr")
+    {
+        AnyInvocable<int()> func;
+        CHECK(!func);
+        CHECK(func == nullptr);
+        func = []() { return 42; };
+        CHECK(func);
+        CHECK(func != nullptr);
+        CHECK(func() == 42);
+        func = nullptr;
+        CHECK(!func);
+        CHECK(func.empty());
+
+        AnyInvocable<int()> func_null(nullptr);
+        CHECK(!func_null);
+        int (*null_fptr)() = nullptr;
+        AnyInvocable<int()> func_null_fptr(null_fptr);
+        CHECK(!func_null_fptr);
+        AnyInvocable<int(MoveOnly*)> func_null_mptr(static_cast<int (MoveOnly::*)()>(nullptr));
+        CHECK(!func_null_mptr);
+    }
+
+    SECTION("In-place construction")
+    {
+        AnyInvocable<int() const> func(std::in_place_type<ConstructorArgs>, 40, std::make_unique<int>(2));
+        CHECK(func() == 42);
+    }
+
+    SECTION("Swap")
+    {
+        AnyInvocable<int()> func1([]() { return 1; });
+        AnyInvocable<int()> func2([p = std::make_unique<int>(2)]() { return *p; });
+        swap(func1, func2);
+        CHECK(func1() == 2);
+        CHECK(func2() == 1);
+    }
+
+#ifndef GHULBUS_CONFIG_ASSERT_LEVEL_PRODUCTION
+    SECTION("Invoking an empty object is a precondition violation")
+    {
+        Assert::setAssertionHandler([](Assert::HandlerParameters const&) { throw 42; });
+        AnyInvocable<int()> func;
+        CHECK_THROWS_AS(func(), int);
+        Assert::setAssertionHandler(&Assert::failAbort);
+    }
+#endif
+}
+
+TEST_CASE("AnyInvocable Allocator")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    auto const big_lambda = [a = std::uintptr_t(1), b = std::uintptr_t(2), c = std::uintptr_t(3),
+                             d = std::uintptr_t(4)]() { return static_cast<int>(a + b + c + d); };
+    static_assert(!AnyInvocable<int()>::storesInline<decltype(big_lambda)>());
+
+    SECTION("Memory resource")
+    {
+        CountingResource resource;
+        {
+            AnyInvocable<int()> func(std::allocator_arg, &resource, big_lambda);
+            CHECK(resource.allocations == 1);
+            CHECK(func() == 10);
+            AnyInvocable<int()> func2(std::move(func));
+            CHECK(resource.allocations == 1);
+            CHECK(func2() == 10);
+            CHECK(resource.deallocations == 0);
+        }
+        CHECK(resource.deallocations == 1);
+    }
+
+    SECTION("Small callables do not use the allocator")
+    {
+        CountingResource resource;
+        AnyInvocable<int()> func(std::allocator_arg, &resource, []() { return 42; });
+        CHECK(func() == 42);
+        CHECK(resource.allocations == 0);
+    }
+
+    SECTION("Polymorphic allocator and monotonic arena")
+    {
+        std::array<std::byte, 1024> buffer;
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        std::pmr::polymorphic_allocator<std::byte> alloc(&arena);
+        std::vector<AnyInvocable<int() const>> funcs;
+        for (int i = 0; i < 10; ++i) {
+            funcs.emplace_back(std::allocator_arg, alloc, big_lambda);
+        }
+        int sum = 0;
+        for (auto const& f : funcs) { sum += f(); }
+        CHECK(sum == 100);
+    }
+
+    SECTION("Allocator template")
+    {
+        int allocations = 0;
+        {
+            AnyInvocable<int()> func(std::allocator_arg, CountingAllocator<int>(&allocations), big_lambda);
+            CHECK(allocations == 1);
+            CHECK(func() == 10);
+        }
+        CHECK(allocations == 0);
+    }
+
+    SECTION("In-place construction with allocator")
+    {
+        CountingResource resource;
+        {
+            struct Big {
+                std::array<int, 16> data;
+                explicit Big(int v) { data.fill(v); }
+                int operator()() const { return data[15]; }
+            };
+            AnyInvocable<int() const> func(std::allocator_arg, &resource, std::in_place_type<Big>, 42);
+            CHECK(func() == 42);
+            CHECK(resource.allocations == 1);
+        }
+        CHECK(resource.deallocations == 1);
+    }
+
+    SECTION("Exception during construction releases memory")
+    {
+        int allocations = 0;
+        struct alignas(64) ThrowingCopy {
+            ThrowingCopy() = default;
+            ThrowingCopy(ThrowingCopy const&) { throw std::runtime_error("copy"); }
+            int operator()() const { return 0; }
+        } throwing;
+        CHECK_THROWS_AS(AnyInvocable<int()>(std::allocator_arg, CountingAllocator<int>(&allocations), throwing),
+                        std::runtime_error);
+        CHECK(allocations == 0);
+    }
+}
+
+TEST_CASE("AnyInvocable Benchmark", "[.][benchmark]")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    int i = 42;
+
+    BENCHMARK("Construct small")
+    {
+        return AnyInvocable<int()>([&i]() { return i; });
+    };
+
+    BENCHMARK("Construct std::function")
+    {
+        return std::function<int()>([&i]() { return i; });
+    };
+
+    BENCHMARK_ADVANCED("Move")(Catch::Benchmark::Chronometer meter)
+    {
+        AnyInvocable<int()> func1([&i]() { return i; });
+        AnyInvocable<int()> func2;
+        meter.measure([&]() {
+            func2 = std::move(func1);
+            func1 = std::move(func2);
+            return func1.empty();
+        });
+    };
+
+    BENCHMARK_ADVANCED("Invoke")(Catch::Benchmark::Chronometer meter)
+    {
+        AnyInvocable<int()> func([&i]() { return i; });
+        meter.measure([&]() { return func(); });
+    };
 }
@@ -1,9 +1,15 @@
 #include <gbBase/Assert.hpp>
 
 #include <gbBase/Exception.hpp>
+#include <gbBase/Log.hpp>
 
 #include <catch.hpp>
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace
 {
 // catch's exception checking does not seem to work
@@ -117,5 +123,87 @@ TEST_CASE("Assert")
         CHECK(g_handlerWasCalled);
     }
 
+    SECTION("Assertion macros pass their site to the handler")
+    {
+        static Assert::Site* s_site;
+        s_site = nullptr;
+        auto handler = [](Assert::HandlerParameters const& param) {
+            s_site = param.site;
+            throw NoReturn();
+        };
+        Assert::setAssertionHandler(handler);
+        auto doAssert = [](int i) { GHULBUS_ASSERT_PRD_MESSAGE(i > 0, "Must be positive"); };
+        doAssert(1);
+        CHECK(!s_site);
+        for (int i = 0; i < 3; ++i) {
+            try {
+                doAssert(0);
+            } catch(NoReturn&) {}
+        }
+        REQUIRE(s_site);
+        CHECK(s_site->failures == 3);
+        CHECK(s_site->condition == std::string("i > 0"));
+        CHECK(std::string(s_site->file).find("TestAssert.cpp") != std::string::npos);
+        CHECK(s_site->line > 0);
+    }
+
+    SECTION("Log and continue handler")
+    {
+        auto guard = Log::initializeLoggingWithGuard();
+        auto const old_log_handler = Log::getLogHandler();
+        static std::vector<std::string> s_logs;
+        s_logs.clear();
+        Log::setLogHandler([](LogLevel, std::stringstream&& os) { s_logs.push_back(os.str()); });
+        Assert::setAssertionHandler(&Assert::failLogAndContinue, Assert::ReturnBehavior::Continue);
+        CHECK(Assert::getAssertionHandlerReturnBehavior() == Assert::ReturnBehavior::Continue);
+        Assert::setLogAndContinueRateLimit(3);
+
+        int continued = 0;
+        for (int i = 0; i < 100; ++i) {
+            GHULBUS_ASSERT_PRD_MESSAGE(i < 0, "Canary");
+            ++continued;
+        }
+        CHECK(continued == 100);
+        // at most 3 logs per minute, but the loop may cross a minute boundary
+        CHECK(s_logs.size() >= 3);
+        CHECK(s_logs.size() <= 6);
+        REQUIRE(!s_logs.empty());
+        CHECK(s_logs.front().find("i < 0 - Canary") != std::string::npos);
+        CHECK(s_logs.front().find("failed 1 times") != std::string::npos);
+
+        // a different site is rate limited independently, and its first failure is always logged
+        Assert::setLogAndContinueRateLimit(0);
+        auto const log_count = s_logs.size();
+        for (int i = 0; i < 10; ++i) {
+            GHULBUS_ASSERT_PRD(i < 0);
+        }
+        CHECK(s_logs.size() == log_count + 1);
+
+        Assert::setLogAndContinueRateLimit(10);
+        Log::setLogHandler(old_log_handler);
+    }
+
+    SECTION("Log and continue handler from multiple threads")
+    {
+        auto guard = Log::initializeLoggingWithGuard();
+        auto const old_log_handler = Log::getLogHandler();
+        static std::atomic<int> s_logCount;
+        s_logCount = 0;
+        Log::setLogHandler([](LogLevel, std::stringstream&&) { ++s_logCount; });
+        Assert::setAssertionHandler(&Assert::failLogAndContinue, Assert::ReturnBehavior::Continue);
+        Assert::setLogAndContinueRateLimit(5);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 1000; ++i) { GHULBUS_ASSERT_PRD(i < 0); }
+            });
+        }
+        for (auto& t : threads) { t.join(); }
+        CHECK(s_logCount >= 5);
+        CHECK(s_logCount <= 10);
+        Assert::setLogAndContinueRateLimit(10);
+        Log::setLogHandler(old_log_handler);
+    }
+
     Assert::setAssertionHandler(&Assert::failAbort);
 }
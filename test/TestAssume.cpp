@@ -0,0 +1,104 @@
+// Test the assertion macros in a production build that turns disabled preconditions into assumptions.
+#undef GHULBUS_CONFIG_ASSERT_LEVEL_DEBUG
+#define GHULBUS_CONFIG_ASSERT_LEVEL_PRODUCTION
+#define GHULBUS_CONFIG_ASSUME_PRECONDITIONS
+#include <gbBase/Assert.hpp>
+
+#include <catch.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+struct NoReturn { };
+
+int elementAt(std::vector<int> const& v, std::size_t i)
+{
+    GHULBUS_PRECONDITION(i < v.size());
+    // the bounds check of at() can be removed by the optimizer
+    return v.at(i);
+}
+
+int elementAtUnchecked(std::vector<int> const& v, std::size_t i)
+{
+    return v.at(i);
+}
+
+int signOf(int i)
+{
+    if (i > 0) { return 1; }
+    if (i < 0) { return -1; }
+    if (i == 0) { return 0; }
+    GHULBUS_UNREACHABLE();
+    return 0;
+}
+}
+
+TEST_CASE("Assume")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Assumptions")
+    {
+        int const i = 42;
+        GHULBUS_ASSUME(i == 42);
+        CHECK(i == 42);
+    }
+
+    SECTION("Disabled preconditions become assumptions")
+    {
+        std::vector<int> v(10);
+        std::iota(v.begin(), v.end(), 0);
+        CHECK(elementAt(v, 5) == 5);
+        GHULBUS_PRECONDITION(!v.empty());
+        GHULBUS_PRECONDITION_DBG(v.size() == 10);
+        GHULBUS_PRECONDITION_MESSAGE(v.front() == 0, "First element must be zero");
+        int evaluations = 0;
+        GHULBUS_PRECONDITION(++evaluations > 0);
+        GHULBUS_ASSUME(++evaluations > 0);
+        CHECK(evaluations == 0);
+        CHECK(signOf(-5) == -1);
+        CHECK(signOf(0) == 0);
+    }
+
+    SECTION("Production preconditions are still checked")
+    {
+        bool handler_was_called = false;
+        static bool* s_handler_was_called;
+        s_handler_was_called = &handler_was_called;
+        Assert::setAssertionHandler([](Assert::HandlerParameters const&) {
+            *s_handler_was_called = true;
+            throw NoReturn();
+        });
+        try {
+            GHULBUS_PRECONDITION_PRD(false);
+        } catch (NoReturn&) {}
+        CHECK(handler_was_called);
+        Assert::setAssertionHandler(&Assert::failAbort);
+    }
+}
+
+TEST_CASE("Assume Benchmark", "[.][benchmark]")
+{
+    std::vector<int> v(1000);
+    std::iota(v.begin(), v.end(), 0);
+    // indices are not known to be in range at compile time
+    std::vector<std::size_t> indices(v.size());
+    for (std::size_t i = 0; i < indices.size(); ++i) { indices[i] = (i * 7) % v.size(); }
+
+    BENCHMARK("Indexing with assumed precondition")
+    {
+        long sum = 0;
+        for (std::size_t i : indices) { sum += elementAt(v, i); }
+        return sum;
+    };
+
+    BENCHMARK("Indexing without precondition")
+    {
+        long sum = 0;
+        for (std::size_t i : indices) { sum += elementAtUnchecked(v, i); }
+        return sum;
+    };
+}
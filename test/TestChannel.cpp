@@ -0,0 +1,165 @@
+#include <gbBase/Channel.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Channel")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    Channel<int> c{ 3 };
+
+    SECTION("Construction")
+    {
+        CHECK(c.capacity() == 3);
+        CHECK(!c.closed());
+        CHECK(c.empty());
+        CHECK(!c.try_pop());
+    }
+
+    SECTION("Try push and pop")
+    {
+        CHECK(c.try_push(1));
+        CHECK(!c.empty());
+        CHECK(c.try_push(2));
+        CHECK(c.try_push(3));
+        CHECK(!c.try_push(4));
+        CHECK(c.try_pop() == 1);
+        CHECK(c.try_push(4));
+        CHECK(c.try_pop() == 2);
+        CHECK(c.try_pop() == 3);
+        CHECK(c.try_pop() == 4);
+        CHECK(c.empty());
+        CHECK(!c.try_pop());
+    }
+
+    SECTION("Blocking push and pop")
+    {
+        CHECK(c.push(42));
+        CHECK(c.pop() == 42);
+    }
+
+    SECTION("Pop with timeout")
+    {
+        CHECK(!c.pop_for(std::chrono::milliseconds(1)));
+        c.push(5);
+        CHECK(c.pop_for(std::chrono::milliseconds(1)) == 5);
+    }
+
+    SECTION("Batch pop")
+    {
+        c.push(1);
+        c.push(2);
+        c.push(3);
+        std::vector<int> v;
+        CHECK(c.pop_batch(std::back_inserter(v), 2) == 2);
+        CHECK(v == std::vector<int>{ 1, 2 });
+        CHECK(c.pop_batch(std::back_inserter(v), 5) == 1);
+        CHECK(v == std::vector<int>{ 1, 2, 3 });
+    }
+
+    SECTION("Close")
+    {
+        c.push(1);
+        c.push(2);
+        c.close();
+        CHECK(c.closed());
+        CHECK(!c.push(3));
+        CHECK(!c.try_push(3));
+        CHECK(c.pop() == 1);
+        CHECK(c.pop() == 2);
+        CHECK(!c.pop());
+        std::vector<int> v;
+        CHECK(c.pop_batch(std::back_inserter(v), 5) == 0);
+    }
+
+    SECTION("Close wakes up blocked consumer")
+    {
+        std::thread consumer([&c]() { CHECK(!c.pop()); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        c.close();
+        consumer.join();
+    }
+
+    SECTION("Close wakes up blocked producer")
+    {
+        c.push(1);
+        c.push(2);
+        c.push(3);
+        std::thread producer([&c]() { CHECK(!c.push(4)); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        c.close();
+        producer.join();
+    }
+
+    SECTION("Multiple producers and consumers")
+    {
+        int const n_threads = 4;
+        int const n_per_thread = 10000;
+        std::atomic<long long> sum = 0;
+        std::atomic<int> count = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&c]() {
+                for (int i = 1; i <= n_per_thread; ++i) { c.push(i); }
+            });
+            threads.emplace_back([&c, &sum, &count]() {
+                while (auto v = c.pop()) {
+                    sum += *v;
+                    ++count;
+                }
+            });
+        }
+        for (int t = 0; t < n_threads; ++t) { threads[2 * t].join(); }
+        c.close();
+        for (int t = 0; t < n_threads; ++t) { threads[2 * t + 1].join(); }
+        CHECK(count == n_threads * n_per_thread);
+        CHECK(sum == static_cast<long long>(n_threads) * n_per_thread * (n_per_thread + 1) / 2);
+    }
+}
+
+TEST_CASE("Channel Non-trivial Types")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Move-only elements")
+    {
+        Channel<std::unique_ptr<int>> c{ 2 };
+        CHECK(c.push(std::make_unique<int>(42)));
+        auto p = c.pop();
+        REQUIRE(p);
+        REQUIRE(*p);
+        CHECK(**p == 42);
+    }
+
+    SECTION("Destruction of remaining elements")
+    {
+        auto const counter = std::make_shared<int>(0);
+        {
+            Channel<std::shared_ptr<int>> c{ 4 };
+            c.push(counter);
+            c.push(counter);
+            CHECK(counter.use_count() == 3);
+        }
+        CHECK(counter.use_count() == 1);
+    }
+
+    SECTION("Copying construction for failed try_push leaves argument intact")
+    {
+        Channel<std::string> c{ 1 };
+        std::string s1 = "Lorem";
+        std::string s2 = "ipsum";
+        CHECK(c.try_push(std::move(s1)));
+        CHECK(!c.try_push(std::move(s2)));
+        CHECK(s2 == "ipsum");
+        CHECK(c.pop() == "Lorem");
+    }
+}
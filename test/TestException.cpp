@@ -2,7 +2,12 @@
 
 #include <catch.hpp>
 
+#include <cstdio>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -34,14 +39,60 @@ struct tag_is_std_string {};
 struct tag_to_string_printable {};
 struct tag_ostream_printable {};
 struct tag_unprintable {};
+struct tag_counter {};
+struct tag_throwing_move {};
+template<int N>
+struct tag_numbered {};
+
+struct ThrowingMove {
+    int i;
+    explicit ThrowingMove(int ii) : i(ii) {}
+    ThrowingMove(ThrowingMove const& rhs) : i(rhs.i) {}
+    ThrowingMove(ThrowingMove&& rhs) noexcept(false) : i(rhs.i) {}
+};
 
 using InfoTestInfo = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_test_tag, TestRecord>;
 using InfoIsStdString = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_is_std_string, std::string>;
 using InfoToStringPrintable = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_to_string_printable, to_string_printable>;
 using InfoOstreamPrintable = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_ostream_printable, ostream_printable>;
 using InfoUnprintable = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_unprintable, unprintable>;
+using InfoCounter = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_counter, int>;
+using InfoThrowingMove = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_throwing_move, ThrowingMove>;
+
+// same name as a decorator in TestExceptionAnonymousTags.cpp
+struct tag_anonymous_context {};
+struct AnonymousContext {
+    std::string s;
+};
+using InfoAnonymousContext = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_anonymous_context, AnonymousContext>;
+}
+
+namespace {
+[[noreturn]] void throwWithStackBuffer(int i)
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "Error number %d", i);
+    GHULBUS_THROW(Exceptions::IOError(), buffer);
+}
+
+[[noreturn]] void throwWithConstStackBuffer()
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    char const buffer[] = "Const buffer";
+    GHULBUS_THROW(Exceptions::IOError(), buffer);
 }
 
+void overwriteStack()
+{
+    char volatile buffer[256];
+    for (auto& c : buffer) { c = 'x'; }
+}
+}
+
+void decorateWithAnonymousIntContext(GHULBUS_BASE_NAMESPACE::Exception const& e, int i);
+int const* getAnonymousIntContext(GHULBUS_BASE_NAMESPACE::Exception const& e);
+
 TEST_CASE("Exception")
 {
     using namespace GHULBUS_BASE_NAMESPACE;
@@ -95,6 +146,17 @@ TEST_CASE("Exception")
         CHECK(info.find("ostream_printable") != std::string::npos);
     }
 
+    SECTION("Exception Message - Arithmetic Types")
+    {
+        Exceptions::NotImplemented e;
+        e << InfoCounter(-42) << ErrorInfo<tag_counter, double>(1.5) << ErrorInfo<tag_counter, bool>(true);
+        std::string const info = getDiagnosticMessage(e);
+        INFO(info);
+        CHECK(info.find("] = -42\n") != std::string::npos);
+        CHECK(info.find("] = 1.5\n") != std::string::npos);
+        CHECK(info.substr(info.size() - 5) == "] = 1");
+    }
+
     SECTION("Exception Message - Unprintable Types")
     {
         Exceptions::NotImplemented e;
@@ -362,4 +424,311 @@ TEST_CASE("Exception")
         tester(Exceptions::InvalidArgument());
         tester(Exceptions::ProtocolViolation());
     }
+
+    SECTION("Decorators overflowing the inline storage")
+    {
+        std::string const testfile("testfile.txt");
+        Exceptions::IOError e;
+        e << Exception_Info::filename(testfile) << InfoThrowingMove(5);
+        for (int i = 0; i < 20; ++i) {
+            e << InfoCounter(i);
+        }
+        e << InfoTestInfo(42, "blablub");
+        auto const check_decorators = [&testfile](Exceptions::IOError const& ex) {
+            REQUIRE(getErrorInfo<Exception_Info::filename>(ex));
+            CHECK(*getErrorInfo<Exception_Info::filename>(ex) == testfile);
+            REQUIRE(getErrorInfo<InfoThrowingMove>(ex));
+            CHECK(getErrorInfo<InfoThrowingMove>(ex)->i == 5);
+            REQUIRE(getErrorInfo<InfoCounter>(ex));
+            CHECK(*getErrorInfo<InfoCounter>(ex) == 19);
+            REQUIRE(getErrorInfo<InfoTestInfo>(ex));
+            CHECK(getErrorInfo<InfoTestInfo>(ex)->s == "blablub");
+        };
+        check_decorators(e);
+        Exceptions::IOError e2(e);
+        check_decorators(e2);
+        Exceptions::IOError e3;
+        e3 = e2;
+        check_decorators(e3);
+        std::string const message = getDiagnosticMessage(e3);
+        CHECK(message.find(testfile) != std::string::npos);
+    }
+
+    SECTION("Copies share decorators overflowing the inline storage")
+    {
+        Exceptions::IOError e;
+        for (int i = 0; i < 20; ++i) {
+            e << InfoCounter(i);
+        }
+        e << Exception_Info::filename("testfile.txt");
+        Exceptions::IOError e2(e);
+        CHECK(getErrorInfo<Exception_Info::filename>(e2) == getErrorInfo<Exception_Info::filename>(e));
+        std::string const* const filename = getErrorInfo<Exception_Info::filename>(e);
+        // adding a decorator to a copy leaves the other copies untouched
+        e2 << Exception_Info::filename("other.txt") << InfoCounter(42);
+        CHECK(getErrorInfo<Exception_Info::filename>(e) == filename);
+        CHECK(*getErrorInfo<Exception_Info::filename>(e) == "testfile.txt");
+        CHECK(*getErrorInfo<InfoCounter>(e) == 19);
+        CHECK(*getErrorInfo<Exception_Info::filename>(e2) == "other.txt");
+        CHECK(*getErrorInfo<InfoCounter>(e2) == 42);
+        {
+            Exceptions::IOError e3(e);
+        }
+        e << InfoCounter(43);
+        CHECK(getErrorInfo<Exception_Info::filename>(e) == filename);
+        CHECK(*getErrorInfo<InfoCounter>(e) == 43);
+    }
+
+    SECTION("Decorator lookup")
+    {
+        static_assert(impl::errorInfoId<tag_counter, int>() != impl::errorInfoId<tag_counter, long>());
+        static_assert(impl::errorInfoId<tag_counter, int>() != impl::errorInfoId<tag_unprintable, int>());
+        Exceptions::IOError e;
+        e << InfoCounter(1) << ErrorInfo<tag_counter, long>(2) << InfoCounter(3);
+        REQUIRE(getErrorInfo<InfoCounter>(e));
+        CHECK(*getErrorInfo<InfoCounter>(e) == 3);
+        REQUIRE((getErrorInfo<ErrorInfo<tag_counter, long>>(e)));
+        CHECK(*getErrorInfo<ErrorInfo<tag_counter, long>>(e) == 2);
+        CHECK(!getErrorInfo<InfoIsStdString>(e));
+    }
+
+    SECTION("Decorator lookup distinguishes types with the same name in different translation units")
+    {
+        Exceptions::IOError e;
+        e << InfoAnonymousContext(AnonymousContext{ "Lorem ipsum" });
+        CHECK(!getAnonymousIntContext(e));
+        decorateWithAnonymousIntContext(e, 42);
+        REQUIRE(getAnonymousIntContext(e));
+        CHECK(*getAnonymousIntContext(e) == 42);
+        REQUIRE(getErrorInfo<InfoAnonymousContext>(e));
+        CHECK(getErrorInfo<InfoAnonymousContext>(e)->s == "Lorem ipsum");
+        e << InfoAnonymousContext(AnonymousContext{ "dolor" });
+        CHECK(*getAnonymousIntContext(e) == 42);
+        CHECK(getErrorInfo<InfoAnonymousContext>(e)->s == "dolor");
+    }
+
+    SECTION("Decorator lookup with many different decorators")
+    {
+        Exceptions::IOError e;
+        [&e]<int... Is>(std::integer_sequence<int, Is...>) {
+            (e << ... << ErrorInfo<tag_numbered<Is>, int>(Is));
+        }(std::make_integer_sequence<int, 12>{});
+        e << ErrorInfo<tag_numbered<3>, int>(42);
+        auto const check_decorators = [](Exceptions::IOError const& ex) {
+            auto const check_decorator = [&ex]<int I>(std::integral_constant<int, I>) {
+                REQUIRE(getErrorInfo<ErrorInfo<tag_numbered<I>, int>>(ex));
+                CHECK(*getErrorInfo<ErrorInfo<tag_numbered<I>, int>>(ex) == ((I == 3) ? 42 : I));
+            };
+            [&check_decorator]<int... Is>(std::integer_sequence<int, Is...>) {
+                (check_decorator(std::integral_constant<int, Is>{}), ...);
+            }(std::make_integer_sequence<int, 12>{});
+            CHECK(!getErrorInfo<ErrorInfo<tag_numbered<12>, int>>(ex));
+        };
+        check_decorators(e);
+        Exceptions::IOError e2(e);
+        check_decorators(e2);
+    }
+    SECTION("Diagnostic message is cached until decorated again")
+    {
+        Exceptions::IOError e;
+        e << InfoIsStdString("first");
+        char const* const msg = e.what();
+        CHECK(e.what() == msg);
+        CHECK(std::string(msg).find("first") != std::string::npos);
+        e << InfoCounter(42);
+        std::string const msg2 = e.what();
+        CHECK(msg2.find("first") != std::string::npos);
+        CHECK(msg2.find("42") != std::string::npos);
+        e << Exception_Info::description("Lorem ipsum");
+        CHECK(std::string(e.what()).find("Lorem ipsum") != std::string::npos);
+        e << Exception_Info::location("testfile.cpp", "testfunc", 12345);
+        CHECK(std::string(e.what()).find("testfile.cpp(12345)") != std::string::npos);
+
+        Exceptions::IOError e2;
+        CHECK(std::string(e2.what()).find("testfile.cpp") == std::string::npos);
+        e2 = e;
+        CHECK(std::string(e2.what()).find("testfile.cpp") != std::string::npos);
+    }
+
+    SECTION("Diagnostic message can be requested concurrently")
+    {
+        Exceptions::IOError e;
+        e << InfoIsStdString("Lorem ipsum") << InfoCounter(42);
+        std::vector<char const*> results(4, nullptr);
+        std::vector<std::thread> threads;
+        for (auto& r : results) {
+            threads.emplace_back([&e, &r]() { r = e.what(); });
+        }
+        for (auto& t : threads) { t.join(); }
+        for (auto const r : results) {
+            CHECK(r == results.front());
+        }
+        CHECK(std::string(results.front()).find("Lorem ipsum") != std::string::npos);
+    }
+    SECTION("String literal descriptions are stored by pointer")
+    {
+        char const* const literal = "Lorem ipsum";
+        try {
+            GHULBUS_THROW(Exceptions::IOError(), "Lorem ipsum");
+        } catch (Exceptions::IOError const& e) {
+            auto const static_desc = getErrorInfo<Exception_Info::static_description>(e);
+            REQUIRE(static_desc);
+            CHECK(*static_desc == literal);
+            CHECK(std::string(e.what()).find(literal) != std::string::npos);
+            auto const desc = getErrorInfo<Exception_Info::description>(e);
+            REQUIRE(desc);
+            CHECK(*desc == literal);
+            Exceptions::IOError e2(e);
+            REQUIRE(getErrorInfo<Exception_Info::static_description>(e2));
+            CHECK(*getErrorInfo<Exception_Info::static_description>(e2) == literal);
+        }
+        try {
+            GHULBUS_THROW(Exceptions::IOError(), std::string(literal));
+        } catch (Exceptions::IOError const& e) {
+            CHECK(!getErrorInfo<Exception_Info::static_description>(e));
+            REQUIRE(getErrorInfo<Exception_Info::description>(e));
+            CHECK(*getErrorInfo<Exception_Info::description>(e) == literal);
+        }
+        Exceptions::IOError e;
+        e << Exception_Info::static_description("first") << Exception_Info::description("second");
+        CHECK(!getErrorInfo<Exception_Info::static_description>(e));
+        CHECK(*getErrorInfo<Exception_Info::description>(e) == "second");
+        e << Exception_Info::static_description("third");
+        CHECK(*getErrorInfo<Exception_Info::description>(e) == "third");
+        CHECK(std::string(e.what()).find("third") != std::string::npos);
+    }
+
+    SECTION("Static descriptions can be inspected concurrently")
+    {
+        char const literal[] = "A static description that is too long for the small string optimization";
+        Exceptions::IOError e;
+        e << Exception_Info::static_description(literal);
+        std::vector<std::string const*> results(4, nullptr);
+        std::vector<std::thread> threads;
+        for (auto& r : results) {
+            threads.emplace_back([&e, &r]() { r = getErrorInfo<Exception_Info::description>(e); });
+        }
+        for (auto& t : threads) { t.join(); }
+        for (auto const r : results) {
+            REQUIRE(r == results.front());
+            CHECK(*r == literal);
+        }
+        Exceptions::IOError e_copy(e);
+        REQUIRE(getErrorInfo<Exception_Info::description>(e_copy));
+        CHECK(*getErrorInfo<Exception_Info::description>(e_copy) == literal);
+        CHECK(getErrorInfo<Exception_Info::description>(e_copy) != results.front());
+    }
+
+    SECTION("Descriptions from named char buffers are copied")
+    {
+        try {
+            throwWithStackBuffer(42);
+        } catch (Exceptions::IOError const& e) {
+            overwriteStack();
+            CHECK(!getErrorInfo<Exception_Info::static_description>(e));
+            REQUIRE(getErrorInfo<Exception_Info::description>(e));
+            CHECK(*getErrorInfo<Exception_Info::description>(e) == "Error number 42");
+            CHECK(std::string(e.what()).find("Error number 42") != std::string::npos);
+        }
+        try {
+            throwWithConstStackBuffer();
+        } catch (Exceptions::IOError const& e) {
+            overwriteStack();
+            CHECK(!getErrorInfo<Exception_Info::static_description>(e));
+            REQUIRE(getErrorInfo<Exception_Info::description>(e));
+            CHECK(*getErrorInfo<Exception_Info::description>(e) == "Const buffer");
+            CHECK(std::string(e.what()).find("Const buffer") != std::string::npos);
+        }
+        static char const* const static_string = "Lorem ipsum";
+        try {
+            GHULBUS_THROW(Exceptions::IOError(), Exception_Info::static_description(static_string));
+        } catch (Exceptions::IOError const& e) {
+            REQUIRE(getErrorInfo<Exception_Info::static_description>(e));
+            CHECK(getErrorInfo<Exception_Info::static_description>(e)->data() == static_string);
+        }
+    }
+
+    SECTION("Stack traces")
+    {
+        auto const st = captureStackTrace();
+        CHECK(st.size <= Exception_Info::Records::stack_trace::max_frames);
+        for (std::size_t i = 0; i < st.size; ++i) { CHECK(st.frames[i] != nullptr); }
+        CHECK(captureStackTrace(st.size + 1).size == 0);
+        Exceptions::IOError e;
+        e << Exception_Info::stack_trace(st);
+        REQUIRE(getErrorInfo<Exception_Info::stack_trace>(e));
+        CHECK(getErrorInfo<Exception_Info::stack_trace>(e)->size == st.size);
+        CHECK(std::string(e.what()).find("stack_trace") != std::string::npos);
+        CHECK(to_string(st).size() >= st.size * 4);
+    }
+
+    SECTION("Stack trace capture can be disabled at runtime")
+    {
+        CHECK(isStackTraceCaptureEnabled());
+        Exceptions::IOError e1;
+        impl::decorateWithStackTrace(e1);
+        CHECK(getErrorInfo<Exception_Info::stack_trace>(e1));
+        setStackTraceCaptureEnabled(false);
+        CHECK(!isStackTraceCaptureEnabled());
+        Exceptions::IOError e2;
+        impl::decorateWithStackTrace(e2);
+        CHECK(!getErrorInfo<Exception_Info::stack_trace>(e2));
+        setStackTraceCaptureEnabled(true);
+    }
+}
+
+TEST_CASE("Exception Benchmark", "[.][benchmark]")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    BENCHMARK("Decorate")
+    {
+        return decorate_exception(Exceptions::IOError(), Exception_Info::filename("testfile.txt"), InfoCounter(42));
+    };
+
+    auto const e = decorate_exception(Exceptions::IOError(), Exception_Info::filename("testfile.txt"),
+                                      InfoCounter(42), InfoIsStdString("Lorem ipsum"));
+    BENCHMARK("Lookup")
+    {
+        return getErrorInfo<InfoCounter>(e);
+    };
+
+    auto const e_big = [&e]() {
+        auto ret = e;
+        for (int i = 0; i < 20; ++i) { ret << InfoCounter(i); }
+        return ret;
+    }();
+    BENCHMARK("Copy")
+    {
+        return Exceptions::IOError(e_big);
+    };
+
+    BENCHMARK("what()")
+    {
+        return e.what();
+    };
+
+    BENCHMARK("Capture stack trace")
+    {
+        return captureStackTrace().size;
+    };
+
+    BENCHMARK("Throw and catch")
+    {
+        try {
+            GHULBUS_THROW(Exceptions::IOError() << InfoCounter(42), "Lorem ipsum");
+        } catch (Exceptions::IOError const& ex) {
+            return *getErrorInfo<InfoCounter>(ex);
+        }
+        return 0;
+    };
+    BENCHMARK("Throw and catch with stack trace")
+    {
+        try {
+            GHULBUS_THROW(impl::decorateWithStackTrace(Exceptions::IOError()), "Lorem ipsum");
+        } catch (Exceptions::IOError const& ex) {
+            return getErrorInfo<Exception_Info::stack_trace>(ex)->size;
+        }
+        return std::size_t{ 0 };
+    };
 }
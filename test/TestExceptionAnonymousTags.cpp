@@ -0,0 +1,22 @@
+#include <gbBase/Exception.hpp>
+
+// Defines decorators with the same names as decorators in an anonymous namespace of TestException.cpp.
+// Their compile-time IDs are identical, but they are different types.
+namespace {
+struct tag_anonymous_context {};
+struct AnonymousContext {
+    int i;
+};
+using InfoAnonymousContext = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_anonymous_context, AnonymousContext>;
+}
+
+void decorateWithAnonymousIntContext(GHULBUS_BASE_NAMESPACE::Exception const& e, int i)
+{
+    e << InfoAnonymousContext(AnonymousContext{ i });
+}
+
+int const* getAnonymousIntContext(GHULBUS_BASE_NAMESPACE::Exception const& e)
+{
+    auto const context = GHULBUS_BASE_NAMESPACE::getErrorInfo<InfoAnonymousContext>(e);
+    return context ? &context->i : nullptr;
+}
@@ -0,0 +1,86 @@
+#define GHULBUS_CONFIG_EXCEPTION_THROW_TELEMETRY
+#include <gbBase/Exception.hpp>
+#include <gbBase/ExceptionTelemetry.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void throwIOError()
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    GHULBUS_THROW(Exceptions::IOError(), "Lorem ipsum");
+}
+
+void throwInvalidArgument(int i)
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    GHULBUS_THROW(Exceptions::InvalidArgument(), "Invalid argument " + std::to_string(i));
+}
+
+GHULBUS_BASE_NAMESPACE::ThrowSiteSnapshot::Site const* findSite(GHULBUS_BASE_NAMESPACE::ThrowSiteSnapshot const& s,
+                                                                std::type_info const& exception_type)
+{
+    auto const it = std::find_if(s.sites.begin(), s.sites.end(), [&exception_type](auto const& site) {
+        return *site.exception_type == exception_type;
+    });
+    return (it != s.sites.end()) ? &(*it) : nullptr;
+}
+}
+
+TEST_CASE("Exception Telemetry")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    auto const s0 = ThrowSiteSnapshot::take();
+    for (int i = 0; i < 3; ++i) {
+        CHECK_THROWS_AS(throwIOError(), Exceptions::IOError);
+    }
+    for (int i = 0; i < 5; ++i) {
+        CHECK_THROWS_AS(throwInvalidArgument(i), Exceptions::InvalidArgument);
+    }
+
+    SECTION("Throws are counted per site")
+    {
+        auto const s1 = ThrowSiteSnapshot::take(&s0);
+        auto const io_site = findSite(s1, typeid(Exceptions::IOError));
+        REQUIRE(io_site);
+        CHECK(io_site->delta == 3);
+        CHECK(io_site->count >= 3);
+        CHECK(std::string(io_site->file).find("TestExceptionTelemetry.cpp") != std::string::npos);
+        CHECK(std::string(io_site->function).find("throwIOError") != std::string::npos);
+        CHECK(io_site->line > 0);
+        auto const arg_site = findSite(s1, typeid(Exceptions::InvalidArgument));
+        REQUIRE(arg_site);
+        CHECK(arg_site->delta == 5);
+        CHECK(arg_site->line > io_site->line);
+        // sorted by delta
+        CHECK(&s1.sites.front() == arg_site);
+        CHECK(s1.interval > std::chrono::steady_clock::duration::zero());
+        CHECK(s1.rate(*arg_site) > s1.rate(*io_site));
+    }
+
+    SECTION("Counting from multiple threads")
+    {
+        auto const s1 = ThrowSiteSnapshot::take();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 100; ++i) {
+                    try { throwIOError(); } catch (Exceptions::IOError const&) {}
+                }
+            });
+        }
+        for (auto& t : threads) { t.join(); }
+        auto const s2 = ThrowSiteSnapshot::take(&s1);
+        auto const io_site = findSite(s2, typeid(Exceptions::IOError));
+        REQUIRE(io_site);
+        CHECK(io_site->delta == 400);
+        CHECK(s2.sites.front().site == io_site->site);
+    }
+}
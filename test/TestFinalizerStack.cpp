@@ -0,0 +1,179 @@
+#include <gbBase/FinalizerStack.hpp>
+#include <gbBase/Finally.hpp>
+
+#include <catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+TEST_CASE("FinalizerStack")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    std::vector<int> order;
+
+    SECTION("Default construction")
+    {
+        FinalizerStack s;
+        CHECK(s.empty());
+        CHECK(s.size() == 0);
+    }
+
+    SECTION("Destruction executes actions in reverse order")
+    {
+        {
+            FinalizerStack s;
+            for (int i = 0; i < 5; ++i) {
+                s.push([&order, i]() { order.push_back(i); });
+            }
+            CHECK(s.size() == 5);
+            CHECK(order.empty());
+        }
+        CHECK(order == std::vector<int>{ 4, 3, 2, 1, 0 });
+    }
+
+    SECTION("Unwind")
+    {
+        FinalizerStack s;
+        s.push([&order]() { order.push_back(0); });
+        s.push([&order]() { order.push_back(1); });
+        s.unwind();
+        CHECK(s.empty());
+        CHECK(order == std::vector<int>{ 1, 0 });
+        s.push([&order]() { order.push_back(2); });
+        s.unwind();
+        CHECK(order == std::vector<int>{ 1, 0, 2 });
+    }
+
+    SECTION("Defuse")
+    {
+        auto p = std::make_shared<int>(42);
+        {
+            FinalizerStack s;
+            s.push([&order, p]() { order.push_back(*p); });
+            s.push([&order, p]() { order.push_back(*p); });
+            CHECK(p.use_count() == 3);
+            s.defuse();
+            CHECK(s.empty());
+            CHECK(p.use_count() == 1);
+        }
+        CHECK(order.empty());
+    }
+
+    SECTION("Many actions spanning multiple chunks")
+    {
+        int sum = 0;
+        {
+            FinalizerStack s(FinalizerStack::UnwindPolicy::Always, 64);
+            for (int i = 0; i < 1000; ++i) {
+                s.push([&sum, i]() { sum += i; });
+            }
+            s.unwind();
+            CHECK(sum == 499500);
+            for (int i = 0; i < 1000; ++i) {
+                s.push([&sum]() { ++sum; });
+            }
+        }
+        CHECK(sum == 500500);
+    }
+
+    SECTION("Big and over-aligned actions")
+    {
+        struct alignas(64) OverAligned {
+            std::vector<int>* order;
+            void operator()() const { order->push_back(reinterpret_cast<std::uintptr_t>(this) % 64 == 0 ? 1 : -1); }
+        };
+        std::array<int, 1000> big{};
+        big.back() = 2;
+        {
+            FinalizerStack s(FinalizerStack::UnwindPolicy::Always, 16);
+            s.push(OverAligned{ &order });
+            s.push([&order, big]() { order.push_back(big.back()); });
+            s.push(OverAligned{ &order });
+        }
+        CHECK(order == std::vector<int>{ 1, 2, 1 });
+    }
+
+    SECTION("Actions may be Finalizers")
+    {
+        {
+            FinalizerStack s;
+            s.push(finally([&order]() { order.push_back(0); }));
+            CHECK(order.empty());
+        }
+        CHECK(order == std::vector<int>{ 0 });
+    }
+
+    SECTION("Rollback on exception")
+    {
+        auto const transaction = [&order](bool fail) {
+            FinalizerStack rollback(FinalizerStack::UnwindPolicy::OnException);
+            rollback.push([&order]() { order.push_back(0); });
+            rollback.push([&order]() { order.push_back(1); });
+            if (fail) { throw std::runtime_error("fail"); }
+        };
+        transaction(false);
+        CHECK(order.empty());
+        CHECK_THROWS_AS(transaction(true), std::runtime_error);
+        CHECK(order == std::vector<int>{ 1, 0 });
+    }
+
+    SECTION("Rollback ignores exceptions already in flight at construction")
+    {
+        struct Guard {
+            std::vector<int>* order;
+            ~Guard() {
+                FinalizerStack rollback(FinalizerStack::UnwindPolicy::OnException);
+                rollback.push([this]() { order->push_back(0); });
+            }
+        };
+        try {
+            Guard g{ &order };
+            throw std::runtime_error("fail");
+        } catch (std::runtime_error&) {}
+        CHECK(order.empty());
+    }
+
+    SECTION("Action is executed if it cannot be stored")
+    {
+        struct ThrowingCopy {
+            std::vector<int>* order;
+            explicit ThrowingCopy(std::vector<int>* o) : order(o) {}
+            ThrowingCopy(ThrowingCopy const&) { throw std::runtime_error("copy"); }
+            void operator()() const { order->push_back(42); }
+        };
+        FinalizerStack s;
+        ThrowingCopy const f(&order);
+        CHECK_THROWS_AS(s.push(f), std::runtime_error);
+        CHECK(order == std::vector<int>{ 42 });
+        CHECK(s.empty());
+    }
+}
+
+TEST_CASE("FinalizerStack Benchmark", "[.][benchmark]")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    int counter = 0;
+
+    BENCHMARK("FinalizerStack push 100")
+    {
+        FinalizerStack s;
+        for (int i = 0; i < 100; ++i) {
+            s.push([&counter]() { ++counter; });
+        }
+    };
+
+    BENCHMARK("std::vector<AnyFinalizer> push 100")
+    {
+        std::vector<AnyFinalizer> v;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(finally([&counter]() { ++counter; }));
+        }
+    };
+}
+}
@@ -2,8 +2,11 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace
 {
@@ -163,6 +166,54 @@ TEST_CASE("AnyFinalizer")
         }
         CHECK(was_invoked == 0);
     }
+
+    SECTION("Small finalizers are stored inline")
+    {
+        int a = 0;
+        int b = 0;
+        int c = 0;
+        auto const finalize_func = [&a, &b, &c]() { ++a; ++b; ++c; };
+        CHECK(AnyFinalizer::storesInline<decltype(finalize_func)>());
+        struct Big { char data[256]; void operator()() const {} };
+        CHECK(!AnyFinalizer::storesInline<Big>());
+    }
+
+    SECTION("Big finalizers")
+    {
+        int was_invoked = 0;
+        std::array<int, 64> payload{};
+        payload.back() = 1;
+        auto const finalize_func = [&was_invoked, payload]() { was_invoked += payload.back(); };
+        CHECK(!AnyFinalizer::storesInline<decltype(finalize_func)>());
+        {
+            AnyFinalizer af{ Finalizer<decltype(finalize_func)>(finalize_func) };
+            AnyFinalizer af_moved(std::move(af));
+            CHECK(!af);
+            CHECK(af_moved);
+            CHECK(was_invoked == 0);
+        }
+        CHECK(was_invoked == 1);
+        {
+            AnyFinalizer af{ Finalizer<decltype(finalize_func)>(finalize_func) };
+            af.defuse();
+        }
+        CHECK(was_invoked == 1);
+    }
+
+    SECTION("Vector of finalizers")
+    {
+        std::vector<int> order;
+        {
+            std::vector<AnyFinalizer> finalizers;
+            for (int i = 0; i < 10; ++i) {
+                finalizers.emplace_back(finally([&order, i]() { order.push_back(i); }));
+            }
+            finalizers[3].defuse();
+            CHECK(order.empty());
+        }
+        std::sort(order.begin(), order.end());
+        CHECK(order == std::vector<int>{ 0, 1, 2, 4, 5, 6, 7, 8, 9 });
+    }
 }
 
 struct FinallyTester {
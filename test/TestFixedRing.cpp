@@ -424,4 +424,91 @@ TEST_CASE("Fixed Ring")
         CHECK(cr.back() == 7);
     }
 
+    SECTION("Pop back")
+    {
+        r.push_back(1);
+        r.push_back(2);
+        r.push_back(3);
+        CHECK(r.pop_back() == 3);
+        CHECK(r.available() == 2);
+        CHECK(r.back() == 2);
+        r.push_back(4);
+        CHECK(r.back() == 4);
+        CHECK(r[0] == 1);
+        CHECK(r[1] == 2);
+        CHECK(r[2] == 4);
+
+        r.push_back(5);
+        r.push_back(6);
+        CHECK(r.full());
+        CHECK(r.pop_front() == 1);
+        CHECK(r.pop_front() == 2);
+        r.push_back(7);
+        CHECK(r.back() == 7);
+        CHECK(r.pop_back() == 7);
+        CHECK(r.back() == 6);
+        CHECK(r.pop_back() == 6);
+        CHECK(r.back() == 5);
+        r.push_back(8);
+        CHECK(r.back() == 8);
+        CHECK(r.front() == 4);
+        CHECK(r.pop_back() == 8);
+        CHECK(r.pop_back() == 5);
+        CHECK(r.pop_back() == 4);
+        CHECK(r.empty());
+        r.push_back(9);
+        CHECK(r.front() == 9);
+        CHECK(r.back() == 9);
+    }
+
+    SECTION("Contiguous segments")
+    {
+        CHECK(r.array_one().empty());
+        CHECK(r.array_two().empty());
+        r.push_back(1);
+        r.push_back(2);
+        r.push_back(3);
+        REQUIRE(r.array_one().size() == 3);
+        CHECK(r.array_one()[0] == 1);
+        CHECK(r.array_one()[2] == 3);
+        CHECK(r.array_two().empty());
+
+        r.pop_front();
+        r.push_back(4);
+        r.push_back(5);
+        r.push_back(6);
+        FixedRing<int> const& cr = r;
+        REQUIRE(cr.array_one().size() == 4);
+        REQUIRE(cr.array_two().size() == 1);
+        CHECK(cr.array_one()[0] == 2);
+        CHECK(cr.array_one()[3] == 5);
+        CHECK(cr.array_two()[0] == 6);
+
+        r.pop_front();
+        r.pop_front();
+        r.pop_front();
+        r.pop_front();
+        REQUIRE(r.array_one().size() == 1);
+        CHECK(r.array_one()[0] == 6);
+        CHECK(r.array_two().empty());
+    }
+}
+
+TEST_CASE("Fixed Ring Benchmark", "[.][benchmark]")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    // every operation checks a precondition, so this measures the overhead of enabled assertions
+    FixedRing<int> r{ 64 };
+    BENCHMARK("Push, index and pop 10000")
+    {
+        long sum = 0;
+        for (int i = 0; i < 10000; ++i) {
+            if (r.full()) { sum += r.pop_front(); }
+            r.push_back(i);
+            sum += r[0] + r[r.available() - 1];
+        }
+        while (!r.empty()) { sum += r.pop_back(); }
+        return sum;
+    };
 }
@@ -0,0 +1,108 @@
+#include <gbBase/FunctionRef.hpp>
+
+#include <catch.hpp>
+
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace {
+int free_function(int i) {
+    return i + 1;
+}
+
+int forEach(std::vector<int> const& v, GHULBUS_BASE_NAMESPACE::FunctionRef<int(int)> f) {
+    int ret = 0;
+    for (int i : v) { ret += f(i); }
+    return ret;
+}
+
+struct Member {
+    int i = 42;
+    int get() const { return i; }
+};
+}
+
+TEST_CASE("FunctionRef")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Size and copy")
+    {
+        static_assert(sizeof(FunctionRef<int(int)>) == 2 * sizeof(void*));
+        static_assert(std::is_trivially_copyable_v<FunctionRef<int(int)>>);
+        static_assert(!std::is_default_constructible_v<FunctionRef<int(int)>>);
+    }
+
+    SECTION("Binding to lambdas")
+    {
+        int count = 0;
+        auto lambda = [&count](int i) { ++count; return i * 2; };
+        FunctionRef<int(int)> f(lambda);
+        CHECK(f(21) == 42);
+        CHECK(count == 1);
+        FunctionRef<int(int)> g = f;
+        CHECK(g(1) == 2);
+        CHECK(count == 2);
+    }
+
+    SECTION("Binding to temporaries for the duration of a call")
+    {
+        std::vector<int> v{ 1, 2, 3 };
+        CHECK(forEach(v, [](int i) { return i * i; }) == 14);
+        CHECK(forEach(v, free_function) == 9);
+        CHECK(forEach(v, &free_function) == 9);
+    }
+
+    SECTION("Binding to function pointers")
+    {
+        int (*fptr)(int) = free_function;
+        FunctionRef<int(int)> f(fptr);
+        fptr = nullptr;
+        CHECK(f(41) == 42);
+    }
+
+    SECTION("Referenced callable is not copied")
+    {
+        struct Stateful {
+            int count = 0;
+            void operator()() { ++count; }
+        } stateful;
+        FunctionRef<void()> f(stateful);
+        f();
+        f();
+        CHECK(stateful.count == 2);
+    }
+
+    SECTION("Const callables")
+    {
+        auto const lambda = [](int i) { return i; };
+        FunctionRef<int(int)> f(lambda);
+        CHECK(f(42) == 42);
+    }
+
+    SECTION("Member pointers")
+    {
+        auto const mptr = &Member::get;
+        FunctionRef<int(Member const&)> f(mptr);
+        CHECK(f(Member{}) == 42);
+    }
+
+    SECTION("Move-only arguments")
+    {
+        FunctionRef<int(std::unique_ptr<int>)> f([](std::unique_ptr<int> p) { return *p; });
+        CHECK(f(std::make_unique<int>(42)) == 42);
+    }
+
+    SECTION("Noexcept")
+    {
+        auto throwing = []() { return 42; };
+        auto nonthrowing = []() noexcept { return 42; };
+        static_assert(!std::is_constructible_v<FunctionRef<int() noexcept>, decltype(throwing)&>);
+        static_assert(std::is_constructible_v<FunctionRef<int() noexcept>, decltype(nonthrowing)&>);
+        FunctionRef<int() noexcept> f(nonthrowing);
+        static_assert(noexcept(f()));
+        CHECK(f() == 42);
+    }
+}
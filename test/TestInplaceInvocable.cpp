@@ -0,0 +1,128 @@
+#include <gbBase/InplaceInvocable.hpp>
+#include <gbBase/FixedRing.hpp>
+
+#include <catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace {
+int free_function() {
+    return 42;
+}
+
+struct alignas(32) Aligned32 {
+    int i = 42;
+
+    std::uintptr_t operator()() const {
+        return reinterpret_cast<std::uintptr_t>(this);
+    }
+};
+
+struct ConstructorArgs {
+    int a;
+    std::unique_ptr<int> b;
+
+    ConstructorArgs(int na, std::unique_ptr<int> nb)
+        :a(na), b(std::move(nb))
+    {}
+
+    int operator()() const { return a + *b; }
+};
+}
+
+TEST_CASE("InplaceInvocable")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Default construction")
+    {
+        InplaceInvocable<void()> f;
+        CHECK(f.empty());
+        CHECK(!f);
+        InplaceInvocable<void()> f_null(nullptr);
+        CHECK(f_null.empty());
+        int (*null_function)() = nullptr;
+        InplaceInvocable<int()> f_null_function(null_function);
+        CHECK(f_null_function.empty());
+    }
+
+    SECTION("Construction from callables")
+    {
+        InplaceInvocable<int()> f1(free_function);
+        CHECK(f1() == 42);
+        InplaceInvocable<int()> f2([i = 42]() { return i; });
+        CHECK(f2() == 42);
+        InplaceInvocable<int(int)> f3([p = std::make_unique<int>(40)](int i) { return *p + i; });
+        CHECK(f3(2) == 42);
+    }
+
+    SECTION("Capacity and alignment")
+    {
+        using Small = InplaceInvocable<int(), sizeof(void*), alignof(void*)>;
+        auto one_pointer = [p = static_cast<void*>(nullptr)]() { return p ? 1 : 0; };
+        auto two_pointers = [p = static_cast<void*>(nullptr), q = static_cast<void*>(nullptr)]() { return p ? 1 : 0; };
+        CHECK(Small::fits<decltype(one_pointer)>());
+        CHECK(!Small::fits<decltype(two_pointers)>());
+        CHECK(!Small::fits<Aligned32>());
+        CHECK(InplaceInvocable<std::uintptr_t(), 32, 32>::fits<Aligned32>());
+
+        InplaceInvocable<std::uintptr_t(), 32, 32> f(Aligned32{});
+        CHECK(f() % 32 == 0);
+        auto g = std::move(f);
+        CHECK(g() % 32 == 0);
+    }
+
+    SECTION("Move")
+    {
+        auto p = std::make_shared<int>(42);
+        InplaceInvocable<int()> f1([p]() { return *p; });
+        CHECK(p.use_count() == 2);
+        InplaceInvocable<int()> f2(std::move(f1));
+        CHECK(f1.empty());
+        CHECK(p.use_count() == 2);
+        CHECK(f2() == 42);
+        f1 = std::move(f2);
+        CHECK(f1() == 42);
+        f1 = nullptr;
+        CHECK(p.use_count() == 1);
+        static_assert(std::is_nothrow_move_constructible_v<InplaceInvocable<int()>>);
+        static_assert(std::is_nothrow_move_assignable_v<InplaceInvocable<int()>>);
+        static_assert(!std::is_copy_constructible_v<InplaceInvocable<int()>>);
+    }
+
+    SECTION("In-place construction")
+    {
+        InplaceInvocable<int()> f(std::in_place_type<ConstructorArgs>, 40, std::make_unique<int>(2));
+        CHECK(f() == 42);
+    }
+
+    SECTION("Noexcept")
+    {
+        auto nonthrowing = []() noexcept { return 42; };
+        auto throwing = []() { return 42; };
+        static_assert(!std::is_constructible_v<InplaceInvocable<int() noexcept>, decltype(throwing)>);
+        InplaceInvocable<int() noexcept> f(nonthrowing);
+        static_assert(noexcept(f()));
+        CHECK(f() == 42);
+    }
+
+    SECTION("Preallocated task queue")
+    {
+        int sum = 0;
+        FixedRing<InplaceInvocable<void()>> queue(4);
+        for (int i = 1; i <= 4; ++i) {
+            queue.push_back([&sum, i]() { sum += i; });
+        }
+        CHECK(queue.full());
+        while (!queue.empty()) {
+            queue.pop_front()();
+        }
+        CHECK(sum == 10);
+        queue.push_back([&sum]() { sum = 0; });
+        queue.pop_front()();
+        CHECK(sum == 0);
+    }
+}
@@ -0,0 +1,129 @@
+#include <gbBase/MulticastRing.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Multicast Ring")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    using Sequence = MulticastRing<int>::Sequence;
+
+    MulticastRing<int> ring{ 4 };
+
+    SECTION("Construction")
+    {
+        CHECK(ring.capacity() == 4);
+        CHECK(ring.published() == 0);
+        CHECK(!ring.closed());
+    }
+
+    SECTION("Every consumer sees every element")
+    {
+        auto& c1 = ring.addConsumer();
+        auto& c2 = ring.addConsumer();
+        CHECK(c1.available() == 0);
+        ring.push(1);
+        ring.push(2);
+        CHECK(ring.published() == 2);
+        REQUIRE(c1.available() == 2);
+        REQUIRE(c2.available() == 2);
+        CHECK(c1.get(0) == 1);
+        CHECK(c1.get(1) == 2);
+        CHECK(c2.get(0) == 1);
+        CHECK(c2.get(1) == 2);
+        c1.release(2);
+        CHECK(c1.cursor() == 2);
+        CHECK(c2.cursor() == 0);
+        CHECK(c2.get(0) == 1);
+    }
+
+    SECTION("Slots are reused in place")
+    {
+        MulticastRing<std::string> sring{ 2 };
+        auto& c = sring.addConsumer();
+        sring.claim() = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+        sring.publish();
+        auto const data = c.get(0).data();
+        c.release(1);
+        sring.push("a");
+        c.release(2);
+        std::string& s = sring.claim();
+        CHECK(s == "Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+        CHECK(s.data() == data);
+        s = "b";
+        sring.publish();
+        CHECK(c.get(2) == "b");
+    }
+
+    SECTION("Dependencies")
+    {
+        auto& first = ring.addConsumer();
+        auto& second = ring.addConsumer({ &first });
+        ring.push(1);
+        ring.push(2);
+        CHECK(first.available() == 2);
+        CHECK(second.available() == 0);
+        first.get(0) = 42;
+        first.release(1);
+        REQUIRE(second.available() == 1);
+        CHECK(second.get(0) == 42);
+    }
+
+    SECTION("Wait for closed ring")
+    {
+        auto& c = ring.addConsumer();
+        ring.push(1);
+        ring.close();
+        CHECK(c.waitFor(0) == 1);
+        c.release(1);
+        CHECK(c.waitFor(1) == 1);
+    }
+
+    SECTION("Concurrent pipeline")
+    {
+        MulticastRing<std::pair<int, int>> pring{ 16 };
+        auto& doubler = pring.addConsumer();
+        auto& summer = pring.addConsumer({ &doubler });
+        auto& counter = pring.addConsumer();
+        int const n_elements = 100000;
+        long long sum_doubled = 0;
+        long long sum_plain = 0;
+        std::thread t_doubler([&doubler]() {
+            for (Sequence seq = doubler.cursor();;) {
+                Sequence const available = doubler.waitFor(seq);
+                if (available <= seq) { break; }
+                for (; seq < available; ++seq) {
+                    doubler.get(seq).second = doubler.get(seq).first * 2;
+                }
+                doubler.release(seq);
+            }
+        });
+        std::thread t_summer([&summer, &sum_doubled]() {
+            for (Sequence seq = summer.cursor();; ++seq) {
+                if (summer.waitFor(seq) <= seq) { break; }
+                sum_doubled += summer.get(seq).second;
+                summer.release(seq + 1);
+            }
+        });
+        std::thread t_counter([&counter, &sum_plain]() {
+            for (Sequence seq = counter.cursor();; ++seq) {
+                if (counter.waitFor(seq) <= seq) { break; }
+                sum_plain += counter.get(seq).first;
+                counter.release(seq + 1);
+            }
+        });
+        for (int i = 1; i <= n_elements; ++i) {
+            pring.push(std::make_pair(i, 0));
+        }
+        pring.close();
+        t_doubler.join();
+        t_summer.join();
+        t_counter.join();
+        long long const expected = static_cast<long long>(n_elements) * (n_elements + 1) / 2;
+        CHECK(sum_plain == expected);
+        CHECK(sum_doubled == 2 * expected);
+    }
+}
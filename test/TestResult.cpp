@@ -0,0 +1,165 @@
+#include <gbBase/Result.hpp>
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace {
+struct tag_position {};
+using InfoPosition = GHULBUS_BASE_NAMESPACE::ErrorInfo<tag_position, int>;
+
+GHULBUS_BASE_NAMESPACE::Result<int> parseDigit(char c, int position)
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    if ((c < '0') || (c > '9')) {
+        return GHULBUS_ERROR(Exceptions::InvalidArgument() << InfoPosition(position), "Not a digit");
+    }
+    return c - '0';
+}
+
+GHULBUS_BASE_NAMESPACE::Result<void> failWithBuffer(int i)
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "Error number %d", i);
+    return GHULBUS_ERROR(Exceptions::InvalidArgument(), buffer);
+}
+
+GHULBUS_BASE_NAMESPACE::Result<void> failWithConstBuffer()
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    char const buffer[] = "Const buffer";
+    return GHULBUS_ERROR(Exceptions::InvalidArgument(), buffer);
+}
+
+void overwriteStack()
+{
+    char volatile buffer[256];
+    for (auto& c : buffer) { c = 'x'; }
+}
+
+GHULBUS_BASE_NAMESPACE::Result<int> parseNumber(std::string const& str)
+{
+    int ret = 0;
+    for (int i = 0; i < static_cast<int>(str.size()); ++i) {
+        auto const digit = parseDigit(str[i], i);
+        if (!digit) { return std::unexpected(digit.error()); }
+        ret = ret * 10 + *digit;
+    }
+    return ret;
+}
+}
+
+TEST_CASE("Result")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Value")
+    {
+        Result<int> const r = parseNumber("42");
+        REQUIRE(r.has_value());
+        CHECK(*r == 42);
+        CHECK(r.value_or_throw() == 42);
+    }
+
+    SECTION("Error carries decorators")
+    {
+        Result<int> const r = parseNumber("4x2");
+        REQUIRE(!r.has_value());
+        Error const& e = r.error();
+        REQUIRE(getErrorInfo<InfoPosition>(e));
+        CHECK(*getErrorInfo<InfoPosition>(e) == 1);
+        REQUIRE(getErrorInfo<Exception_Info::description>(e));
+        CHECK(*getErrorInfo<Exception_Info::description>(e) == "Not a digit");
+        REQUIRE(getErrorInfo<Exception_Info::location>(e));
+        CHECK(getErrorInfo<Exception_Info::location>(e)->line > 0);
+        CHECK(std::string(getDiagnosticMessage(e)).find("Not a digit") != std::string::npos);
+    }
+
+    SECTION("value_or_throw throws the original exception type")
+    {
+        bool was_caught = false;
+        try {
+            parseNumber("4x2").value_or_throw();
+        } catch (Exceptions::InvalidArgument const& e) {
+            was_caught = true;
+            REQUIRE(getErrorInfo<InfoPosition>(e));
+            CHECK(*getErrorInfo<InfoPosition>(e) == 1);
+            CHECK(std::string(e.what()).find("Not a digit") != std::string::npos);
+        }
+        CHECK(was_caught);
+
+        Result<int> const r = parseNumber("x");
+        CHECK_THROWS_AS(r.value_or_throw(), Exceptions::InvalidArgument);
+        CHECK_THROWS_AS(r.value_or_throw(), Exceptions::InvalidArgument);
+    }
+
+    SECTION("Decorating errors")
+    {
+        Result<int> r = parseNumber("x");
+        REQUIRE(!r);
+        r.error() << Exception_Info::filename("numbers.txt");
+        REQUIRE(getErrorInfo<Exception_Info::filename>(r.error()));
+        CHECK(*getErrorInfo<Exception_Info::filename>(r.error()) == "numbers.txt");
+        Result<int> const copy = r;
+        REQUIRE(getErrorInfo<Exception_Info::filename>(copy.error()));
+        r.error() << Exception_Info::filename("other.txt");
+        CHECK(*getErrorInfo<Exception_Info::filename>(copy.error()) == "numbers.txt");
+    }
+
+    SECTION("Descriptions are only stored by pointer for string literals")
+    {
+        Result<int> const r = parseNumber("x");
+        REQUIRE(!r);
+        CHECK(getErrorInfo<Exception_Info::static_description>(r.error()));
+
+        Result<void> const r1 = failWithBuffer(42);
+        overwriteStack();
+        REQUIRE(!r1);
+        CHECK(!getErrorInfo<Exception_Info::static_description>(r1.error()));
+        REQUIRE(getErrorInfo<Exception_Info::description>(r1.error()));
+        CHECK(*getErrorInfo<Exception_Info::description>(r1.error()) == "Error number 42");
+
+        Result<void> const r2 = failWithConstBuffer();
+        overwriteStack();
+        REQUIRE(!r2);
+        CHECK(!getErrorInfo<Exception_Info::static_description>(r2.error()));
+        REQUIRE(getErrorInfo<Exception_Info::description>(r2.error()));
+        CHECK(*getErrorInfo<Exception_Info::description>(r2.error()) == "Const buffer");
+    }
+
+    SECTION("Moved-from errors can be copied")
+    {
+        Result<int> r = parseNumber("x");
+        REQUIRE(!r);
+        Error e = std::move(r.error());
+        Result<int> const copy = r;
+        CHECK(!copy.has_value());
+        Error e2(e);
+        Error const moved_from_copy(r.error());
+        e2 = moved_from_copy;
+        REQUIRE(getErrorInfo<InfoPosition>(e));
+        CHECK(*getErrorInfo<InfoPosition>(e) == 0);
+    }
+
+    SECTION("Void results")
+    {
+        auto const check = [](bool fail) -> Result<void> {
+            if (fail) { return GHULBUS_ERROR(Exceptions::ProtocolViolation(), std::string("failed")); }
+            return {};
+        };
+        CHECK(check(false).has_value());
+        check(false).value_or_throw();
+        CHECK_THROWS_AS(check(true).value_or_throw(), Exceptions::ProtocolViolation);
+    }
+
+    SECTION("Move-only values")
+    {
+        auto const make = []() -> Result<std::unique_ptr<int>> { return std::make_unique<int>(42); };
+        std::unique_ptr<int> p = make().value_or_throw();
+        REQUIRE(p);
+        CHECK(*p == 42);
+    }
+}
@@ -0,0 +1,127 @@
+#include <gbBase/SlidingWindow.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+
+TEST_CASE("Sliding Window")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SlidingWindow<double> w{ 4 };
+
+    SECTION("Construction")
+    {
+        CHECK(w.capacity() == 4);
+        CHECK(w.size() == 0);
+        CHECK(w.empty());
+        CHECK(w.sum() == 0.0);
+    }
+
+    SECTION("Running values")
+    {
+        w.push(1.0);
+        CHECK(w.sum() == 1.0);
+        CHECK(w.mean() == 1.0);
+        CHECK(w.variance() == 0.0);
+        w.push(2.0);
+        w.push(3.0);
+        w.push(4.0);
+        CHECK(w.full());
+        CHECK(w.sum() == Catch::Approx(10.0));
+        CHECK(w.mean() == Catch::Approx(2.5));
+        CHECK(w.variance() == Catch::Approx(1.25));
+        CHECK(w.stddev() == Catch::Approx(std::sqrt(1.25)));
+
+        w.push(5.0);
+        CHECK(w.size() == 4);
+        CHECK(w.sum() == Catch::Approx(14.0));
+        CHECK(w.mean() == Catch::Approx(3.5));
+        CHECK(w.variance() == Catch::Approx(1.25));
+    }
+
+    SECTION("Min and max")
+    {
+        w.push(3.0);
+        CHECK(w.min() == 3.0);
+        CHECK(w.max() == 3.0);
+        w.push(1.0);
+        w.push(4.0);
+        w.push(1.0);
+        CHECK(w.min() == 1.0);
+        CHECK(w.max() == 4.0);
+        w.push(5.0);                        // evicts 3
+        CHECK(w.min() == 1.0);
+        CHECK(w.max() == 5.0);
+        w.push(2.0);                        // evicts 1
+        CHECK(w.min() == 1.0);
+        w.push(6.0);                        // evicts 4
+        CHECK(w.min() == 1.0);
+        w.push(7.0);                        // evicts second 1
+        CHECK(w.min() == 2.0);
+        CHECK(w.max() == 7.0);
+    }
+
+    SECTION("Min and max match brute force")
+    {
+        SlidingWindow<double> w7{ 7 };
+        std::deque<double> reference;
+        double x = 0.5;
+        for (int i = 0; i < 200; ++i) {
+            x = std::fmod(x * 7.31 + 0.77, 10.0);
+            w7.push(x);
+            reference.push_back(x);
+            if (reference.size() > 7) { reference.pop_front(); }
+            CHECK(w7.min() == *std::min_element(reference.begin(), reference.end()));
+            CHECK(w7.max() == *std::max_element(reference.begin(), reference.end()));
+            double const ref_sum = std::accumulate(reference.begin(), reference.end(), 0.0);
+            CHECK(w7.sum() == Catch::Approx(ref_sum));
+        }
+    }
+
+    SECTION("Percentile")
+    {
+        w.push(4.0);
+        CHECK(w.percentile(0.5) == 4.0);
+        w.push(1.0);
+        w.push(3.0);
+        w.push(2.0);
+        CHECK(w.percentile(0.0) == 1.0);
+        CHECK(w.percentile(1.0) == 4.0);
+        CHECK(w.percentile(0.5) == Catch::Approx(2.5));
+        CHECK(w.percentile(1.0 / 3.0) == Catch::Approx(2.0));
+        w.push(10.0);                       // evicts 4, wraps around the ring
+        CHECK(w.percentile(1.0) == 10.0);
+        CHECK(w.percentile(0.0) == 1.0);
+        CHECK(w.percentile(2.0 / 3.0) == Catch::Approx(3.0));
+    }
+
+    SECTION("Recalculate")
+    {
+        for (int i = 0; i < 11; ++i) { w.push(static_cast<double>(i)); }
+        double const sum = w.sum();
+        double const mean = w.mean();
+        double const variance = w.variance();
+        w.recalculate();
+        CHECK(w.sum() == Catch::Approx(sum));
+        CHECK(w.mean() == Catch::Approx(mean));
+        CHECK(w.variance() == Catch::Approx(variance));
+        CHECK(w.sum() == Catch::Approx(7.0 + 8.0 + 9.0 + 10.0));
+    }
+
+    SECTION("Clear")
+    {
+        w.push(1.0);
+        w.push(2.0);
+        w.clear();
+        CHECK(w.empty());
+        CHECK(w.sum() == 0.0);
+        w.push(5.0);
+        CHECK(w.min() == 5.0);
+        CHECK(w.max() == 5.0);
+        CHECK(w.mean() == 5.0);
+    }
+}
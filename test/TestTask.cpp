@@ -0,0 +1,155 @@
+#include <gbBase/Task.hpp>
+#include <gbBase/ThreadPool.hpp>
+
+#include <catch.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+using GHULBUS_BASE_NAMESPACE::Task;
+
+Task<int> answer()
+{
+    co_return 42;
+}
+
+Task<int> addOne(int i)
+{
+    int const v = co_await answer();
+    co_return v + i - 41;
+}
+
+Task<void> throwing()
+{
+    throw std::runtime_error("error");
+    co_return;
+}
+
+Task<std::unique_ptr<int>> moveOnly()
+{
+    co_return std::make_unique<int>(42);
+}
+
+Task<int> countDown(int n)
+{
+    if (n == 0) { co_return 0; }
+    co_return 1 + co_await countDown(n - 1);
+}
+
+Task<int> sumLoop(int n)
+{
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += co_await answer();
+    }
+    co_return sum;
+}
+
+Task<std::thread::id> threadAfterResume(GHULBUS_BASE_NAMESPACE::ThreadPool& pool)
+{
+    co_await GHULBUS_BASE_NAMESPACE::resumeOn(pool);
+    co_return std::this_thread::get_id();
+}
+
+Task<int> fanOut(GHULBUS_BASE_NAMESPACE::ThreadPool& pool, int n)
+{
+    co_await GHULBUS_BASE_NAMESPACE::resumeOn(pool);
+    if (n < 2) { co_return n; }
+    int const a = co_await fanOut(pool, n - 1);
+    int const b = co_await fanOut(pool, n - 2);
+    co_return a + b;
+}
+}
+
+TEST_CASE("Task")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Sync wait returns value")
+    {
+        CHECK(syncWait(answer()) == 42);
+        CHECK(syncWait(addOne(1)) == 2);
+        CHECK(*syncWait(moveOnly()) == 42);
+    }
+
+    SECTION("Tasks are started lazily")
+    {
+        bool started = false;
+        // the lambda must outlive the coroutine, as the coroutine frame only references its captures
+        auto const start = [&started]() -> Task<void> { started = true; co_return; };
+        auto t = start();
+        CHECK(t.valid());
+        CHECK(!started);
+        CHECK(!t.done());
+        syncWait(std::move(t));
+        CHECK(started);
+    }
+
+    SECTION("Exceptions propagate to the awaiting coroutine")
+    {
+        CHECK_THROWS_AS(syncWait(throwing()), std::runtime_error);
+        auto catcher = []() -> Task<std::string> {
+            try {
+                co_await throwing();
+            } catch (std::runtime_error& e) {
+                co_return e.what();
+            }
+            co_return "";
+        };
+        CHECK(syncWait(catcher()) == "error");
+    }
+
+    SECTION("Symmetric transfer does not grow the stack")
+    {
+        // gcc only turns symmetric transfer into a tail call in optimized builds
+#if defined(__OPTIMIZE__) || defined(__clang__) || defined(_MSC_VER)
+        int const n = 100000;
+#else
+        int const n = 1000;
+#endif
+        CHECK(syncWait(sumLoop(n)) == 42 * n);
+        CHECK(syncWait(countDown(n)) == n);
+    }
+
+    SECTION("Move")
+    {
+        Task<int> t1 = answer();
+        Task<int> t2 = std::move(t1);
+        CHECK(!t1.valid());
+        CHECK(t2.valid());
+        t1 = addOne(2);
+        CHECK(syncWait(std::move(t1)) == 3);
+        CHECK(syncWait(std::move(t2)) == 42);
+    }
+
+    SECTION("Destroying an unstarted task")
+    {
+        auto p = std::make_shared<int>(42);
+        {
+            auto t = [](std::shared_ptr<int> sp) -> Task<int> { co_return *sp; }(p);
+            CHECK(p.use_count() == 2);
+        }
+        CHECK(p.use_count() == 1);
+    }
+
+    SECTION("Resume on executor")
+    {
+        ThreadPool pool(2);
+        CHECK(syncWait(threadAfterResume(pool)) != std::this_thread::get_id());
+        CHECK(syncWait(fanOut(pool, 15)) == 610);
+    }
+
+    SECTION("Frame recycling")
+    {
+        void* p1 = impl::allocateCoroutineFrame(100);
+        impl::deallocateCoroutineFrame(p1, 100);
+        void* p2 = impl::allocateCoroutineFrame(120);
+        CHECK(p1 == p2);
+        impl::deallocateCoroutineFrame(p2, 120);
+        void* big = impl::allocateCoroutineFrame(1 << 16);
+        impl::deallocateCoroutineFrame(big, 1 << 16);
+    }
+}
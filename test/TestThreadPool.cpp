@@ -0,0 +1,208 @@
+#include <gbBase/ThreadPool.hpp>
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::uint64_t fib(GHULBUS_BASE_NAMESPACE::ThreadPool& pool, int n)
+{
+    if (n < 2) { return static_cast<std::uint64_t>(n); }
+    auto f = pool.submit([&pool, n]() { return fib(pool, n - 1); });
+    std::uint64_t const b = fib(pool, n - 2);
+    return f.get() + b;
+}
+}
+
+TEST_CASE("ThreadPool")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+
+    SECTION("Construction")
+    {
+        ThreadPool pool(3);
+        CHECK(pool.size() == 3);
+        CHECK(!pool.isWorkerThread());
+        ThreadPool default_pool;
+        CHECK(default_pool.size() >= 1);
+    }
+
+    SECTION("Submit returns result")
+    {
+        ThreadPool pool(2);
+        auto f = pool.submit([]() { return 42; });
+        CHECK(f.valid());
+        CHECK(f.get() == 42);
+        CHECK(f.ready());
+        auto fs = pool.submit([]() { return std::string("Lorem ipsum"); });
+        CHECK(fs.get() == "Lorem ipsum");
+        auto f_worker = pool.submit([&pool]() { return pool.isWorkerThread(); });
+        CHECK(f_worker.get());
+    }
+
+    SECTION("Submit propagates exceptions")
+    {
+        ThreadPool pool(2);
+        auto f = pool.submit([]() -> int { throw std::runtime_error("error"); });
+        CHECK_THROWS_AS(f.get(), std::runtime_error);
+    }
+
+    SECTION("Move-only tasks")
+    {
+        ThreadPool pool(1);
+        auto p = std::make_unique<int>(42);
+        auto f = pool.submit([p = std::move(p)]() { return *p; });
+        CHECK(f.get() == 42);
+    }
+
+    SECTION("Post from multiple threads")
+    {
+        std::atomic<int> counter(0);
+        {
+            ThreadPool pool(4);
+            std::vector<std::thread> producers;
+            for (int i = 0; i < 4; ++i) {
+                producers.emplace_back([&pool, &counter]() {
+                    for (int j = 0; j < 1000; ++j) {
+                        pool.post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                });
+            }
+            for (auto& t : producers) { t.join(); }
+        }
+        // destructor runs all outstanding tasks
+        CHECK(counter.load() == 4000);
+    }
+
+    SECTION("Post more tasks from outside than fit into the injection queue")
+    {
+        std::atomic<int> counter(0);
+        std::size_t const n_tasks = 3 * ThreadPool::injection_queue_capacity;
+        {
+            ThreadPool pool(2);
+            std::vector<ThreadPool::Task> tasks;
+            for (std::size_t i = 0; i < n_tasks; ++i) {
+                tasks.push_back([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+            pool.post(tasks);
+            for (std::size_t i = 0; i < n_tasks; ++i) {
+                pool.post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+        }
+        CHECK(counter.load() == static_cast<int>(2 * n_tasks));
+    }
+
+    SECTION("Nested tasks with helping wait")
+    {
+        ThreadPool pool(2);
+        auto f = pool.submit([&pool]() { return fib(pool, 18); });
+        CHECK(f.get() == 2584);
+
+        ThreadPool single(1);
+        auto fs = single.submit([&single]() { return fib(single, 12); });
+        CHECK(fs.get() == 144);
+    }
+
+    SECTION("Tasks posted from workers")
+    {
+        std::atomic<int> counter(0);
+        {
+            ThreadPool pool(3);
+            for (int i = 0; i < 10; ++i) {
+                pool.post([&pool, &counter]() {
+                    for (int j = 0; j < 1000; ++j) {
+                        pool.post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                });
+            }
+        }
+        CHECK(counter.load() == 10000);
+    }
+
+    SECTION("Bulk submit")
+    {
+        ThreadPool pool(4);
+        std::vector<int> results(100, 0);
+        std::vector<std::function<void()>> tasks;
+        for (int i = 0; i < 100; ++i) {
+            tasks.push_back([&results, i]() { results[i] = i * i; });
+        }
+        auto f = pool.bulk_submit(tasks.begin(), tasks.end());
+        f.get();
+        for (int i = 0; i < 100; ++i) { CHECK(results[i] == i * i); }
+
+        std::vector<std::function<void()>> no_tasks;
+        auto f_empty = pool.bulk_submit(no_tasks.begin(), no_tasks.end());
+        CHECK(f_empty.ready());
+
+        std::vector<std::function<void()>> throwing_tasks(10, []() { throw std::runtime_error("error"); });
+        auto f_throw = pool.bulk_submit(throwing_tasks.begin(), throwing_tasks.end());
+        CHECK_THROWS_AS(f_throw.get(), std::runtime_error);
+    }
+
+    SECTION("Parallel for")
+    {
+        ThreadPool pool(4);
+        for (std::size_t grain : { 1, 7, 64, 1000, 5000 }) {
+            std::vector<int> v(3000, 0);
+            pool.parallel_for(0, v.size(), grain, [&v](std::size_t i) { v[i] += static_cast<int>(i); });
+            bool all_set = true;
+            for (std::size_t i = 0; i < v.size(); ++i) { all_set = all_set && (v[i] == static_cast<int>(i)); }
+            CHECK(all_set);
+        }
+
+        std::atomic<int> calls(0);
+        pool.parallel_for(10, 10, 1, [&calls](std::size_t) { ++calls; });
+        CHECK(calls == 0);
+        pool.parallel_for(10, 15, 1, [&calls](std::size_t i) { CHECK((i >= 10 && i < 15)); ++calls; });
+        CHECK(calls == 5);
+
+        CHECK_THROWS_AS(pool.parallel_for(0, 1000, 10, [](std::size_t i) {
+            if (i == 500) { throw std::runtime_error("error"); }
+        }), std::runtime_error);
+    }
+
+    SECTION("Nested parallel for")
+    {
+        ThreadPool pool(3);
+        std::atomic<int> sum(0);
+        pool.parallel_for(0, 10, 1, [&](std::size_t) {
+            pool.parallel_for(0, 100, 10, [&](std::size_t) { sum.fetch_add(1, std::memory_order_relaxed); });
+        });
+        CHECK(sum.load() == 1000);
+    }
+}
+
+TEST_CASE("ThreadPool Benchmark", "[.][benchmark]")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    std::size_t const max_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<double> data(1 << 20, 1.0);
+    for (std::size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        ThreadPool pool(n_threads);
+        BENCHMARK("parallel_for, " + std::to_string(n_threads) + " threads")
+        {
+            pool.parallel_for(0, data.size(), 4096, [&data](std::size_t i) { data[i] = data[i] * 1.0001 + 0.5; });
+            return data[0];
+        };
+        BENCHMARK("10000 tasks, " + std::to_string(n_threads) + " threads")
+        {
+            std::atomic<int> counter(0);
+            auto f = pool.submit([&pool, &counter]() {
+                std::vector<std::function<void()>> tasks(10000,
+                    [&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                pool.bulk_submit(tasks.begin(), tasks.end()).get();
+            });
+            f.get();
+            return counter.load();
+        };
+        if ((n_threads < max_threads) && (n_threads * 2 > max_threads)) { n_threads = max_threads / 2; }
+    }
+}
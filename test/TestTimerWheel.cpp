@@ -0,0 +1,160 @@
+#include <gbBase/TimerWheel.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Timer Wheel")
+{
+    using namespace GHULBUS_BASE_NAMESPACE;
+    using Tick = TimerWheel::Tick;
+
+    TimerWheel w;
+
+    SECTION("Construction")
+    {
+        CHECK(w.now() == 0);
+        CHECK(w.empty());
+        CHECK(w.size() == 0);
+        TimerWheel w2(42);
+        CHECK(w2.now() == 42);
+    }
+
+    SECTION("Timer fires after delay")
+    {
+        std::vector<Tick> fired;
+        w.schedule(3, [&]() { fired.push_back(w.now()); });
+        CHECK(w.size() == 1);
+        CHECK(w.tick() == 0);
+        CHECK(w.tick() == 0);
+        CHECK(fired.empty());
+        CHECK(w.tick() == 1);
+        CHECK(fired == std::vector<Tick>{ 3 });
+        CHECK(w.empty());
+        CHECK(w.advance(1000) == 0);
+    }
+
+    SECTION("Zero delay fires on next tick")
+    {
+        int n_fired = 0;
+        w.schedule(0, [&]() { ++n_fired; });
+        w.tick();
+        CHECK(n_fired == 1);
+    }
+
+    SECTION("Cancel")
+    {
+        int n_fired = 0;
+        auto const id = w.schedule(5, [&]() { ++n_fired; });
+        CHECK(w.cancel(id));
+        CHECK(w.empty());
+        CHECK(!w.cancel(id));
+        w.advance(10);
+        CHECK(n_fired == 0);
+
+        auto const id2 = w.schedule(1, [&]() { ++n_fired; });
+        w.tick();
+        CHECK(n_fired == 1);
+        CHECK(!w.cancel(id2));
+        CHECK(!w.cancel(TimerWheel::TimerId{}));
+    }
+
+    SECTION("Node reuse does not confuse handles")
+    {
+        auto const id1 = w.schedule(5, []() {});
+        CHECK(w.cancel(id1));
+        auto const id2 = w.schedule(5, []() {});
+        CHECK(id1.index == id2.index);
+        CHECK(id1 != id2);
+        CHECK(!w.cancel(id1));
+        CHECK(w.size() == 1);
+        CHECK(w.cancel(id2));
+    }
+
+    SECTION("Callbacks may cancel other timers expiring on the same tick")
+    {
+        int n_fired = 0;
+        TimerWheel::TimerId ids[2];
+        ids[0] = w.schedule(2, [&]() { ++n_fired; w.cancel(ids[1]); });
+        ids[1] = w.schedule(2, [&]() { ++n_fired; w.cancel(ids[0]); });
+        w.advance(2);
+        CHECK(n_fired == 1);
+        CHECK(w.empty());
+    }
+
+    SECTION("Callbacks may schedule new timers")
+    {
+        std::vector<Tick> fired;
+        w.schedule(1, [&]() {
+            fired.push_back(w.now());
+            w.schedule(1, [&]() { fired.push_back(w.now()); });
+        });
+        w.advance(5);
+        CHECK(fired == std::vector<Tick>{ 1, 2 });
+    }
+
+    SECTION("Periodic timers")
+    {
+        std::vector<Tick> fired;
+        auto const id = w.schedulePeriodic(3, [&]() { fired.push_back(w.now()); });
+        w.advance(10);
+        CHECK(fired == std::vector<Tick>{ 3, 6, 9 });
+        CHECK(w.size() == 1);
+        CHECK(w.cancel(id));
+        w.advance(10);
+        CHECK(fired.size() == 3);
+    }
+
+    SECTION("Periodic timer cancelling itself")
+    {
+        int n_fired = 0;
+        TimerWheel::TimerId id;
+        id = w.schedulePeriodic(2, [&]() { if (++n_fired == 2) { w.cancel(id); } });
+        w.advance(20);
+        CHECK(n_fired == 2);
+        CHECK(w.empty());
+    }
+
+    SECTION("Exceptions from callbacks")
+    {
+        int n_fired = 0;
+        w.schedule(1, []() { throw std::runtime_error("test"); });
+        w.schedule(1, [&]() { ++n_fired; });
+        CHECK_THROWS_AS(w.tick(), std::runtime_error);
+        CHECK(w.now() == 1);
+        w.tick();
+        CHECK(n_fired == 1);
+        CHECK(w.empty());
+    }
+
+    SECTION("Timers across all levels fire on time")
+    {
+        std::map<Tick, int> expected;
+        std::map<Tick, int> fired;
+        Tick const delays[] = { 1, 2, 255, 256, 257, 511, 512, 1000, 16383, 16384, 16385, 70000,
+                                (Tick(1) << 20) - 1, Tick(1) << 20, (Tick(1) << 20) + 1, (Tick(1) << 20) + 12345 };
+        w.advance(77);
+        for (Tick d : delays) {
+            ++expected[w.now() + d];
+            w.schedule(d, [&fired, &w]() { ++fired[w.now()]; });
+        }
+        std::uint64_t n_invoked = 0;
+        while (!w.empty()) { n_invoked += w.tick(); }
+        CHECK(n_invoked == std::size(delays));
+        CHECK(fired == expected);
+    }
+
+    SECTION("Cascading across the range of the upper levels")
+    {
+        TimerWheel w2((Tick(1) << 32) - 3);
+        int n_fired = 0;
+        w2.schedule((Tick(1) << 20) + 7, [&]() { ++n_fired; });
+        w2.advance((Tick(1) << 20) + 6);
+        CHECK(n_fired == 0);
+        w2.tick();
+        CHECK(n_fired == 1);
+    }
+}